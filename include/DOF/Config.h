@@ -36,6 +36,8 @@ public:
    void SetLogLevel(DOF_LogLevel logLevel) { m_logLevel = logLevel; }
    DOF_LogCallback GetLogCallback() const { return m_logCallback; }
    void SetLogCallback(DOF_LogCallback callback) { m_logCallback = callback; }
+   bool IsAsyncInit() const { return m_asyncInit; }
+   void SetAsyncInit(bool asyncInit) { m_asyncInit = asyncInit; }
 
 private:
    Config();
@@ -46,6 +48,7 @@ private:
    std::string m_basePath;
    DOF_LogLevel m_logLevel;
    DOF_LogCallback m_logCallback;
+   bool m_asyncInit;
 };
 
 } // namespace DOF
@@ -67,6 +67,8 @@ public:
    ~DOF();
 
    void Init(const char* tableFilename, const char* romName);
+   bool IsInitComplete() const;
+   bool IsInitFailed() const;
    void DataReceive(char type, int number, int value);
    void Finish();
 
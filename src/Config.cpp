@@ -17,6 +17,7 @@ Config::Config()
 {
    m_logLevel = DOF_LogLevel_INFO;
    m_logCallback = nullptr;
+   m_asyncInit = false;
 }
 
 }
@@ -45,10 +45,19 @@ void DOF::Init(const char* tableFilename, const char* romName)
       }
    }
 
-   m_pinball->Setup(globalConfigPath, tableFilename, romName);
-   m_pinball->Init();
+   if (config->IsAsyncInit())
+      m_pinball->SetupAsync(globalConfigPath, tableFilename, romName);
+   else
+   {
+      m_pinball->Setup(globalConfigPath, tableFilename, romName);
+      m_pinball->Init();
+   }
 }
 
+bool DOF::IsInitComplete() const { return m_pinball->IsSetupComplete(); }
+
+bool DOF::IsInitFailed() const { return m_pinball->IsSetupFailed(); }
+
 void DOF::DataReceive(char type, int number, int value) { m_pinball->ReceiveData(type, number, value); }
 
 void DOF::Finish() { m_pinball->Finish(); }
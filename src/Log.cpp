@@ -5,6 +5,7 @@
 
 #include <iostream>
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
@@ -17,16 +18,28 @@ std::ofstream Log::m_logger;
 bool Log::m_isInitialized = false;
 bool Log::m_isOk = false;
 bool Log::m_isEnabled = true;
+const int Log::WriterFlushIntervalMs;
 std::mutex Log::m_locker;
+std::unique_ptr<LogLineQueue> Log::m_queue;
+std::thread Log::m_writerThread;
+std::atomic<bool> Log::m_writerActive(false);
+std::atomic<bool> Log::m_flushRequested(false);
+std::mutex Log::m_writerMutex;
+std::condition_variable Log::m_writerCondition;
+uint64_t Log::m_reportedDroppedLineCount = 0;
+Log::WriterGuard Log::m_writerGuard;
 
 std::string Log::m_filename = "./DirectOutput.log";
 std::string Log::m_instrumentations = "";
 std::unordered_set<std::string> Log::m_activeInstrumentations;
+std::unordered_map<std::string, std::unique_ptr<std::atomic<bool>>> Log::m_instrumentationFlags;
+std::mutex Log::m_instrumentationLocker;
 std::vector<std::string> Log::m_preLogFileLog;
 std::unordered_set<std::string> Log::m_onceKeys;
 
 void Log::SetInstrumentations(const std::string& instrumentations)
 {
+   std::lock_guard<std::mutex> lock(m_instrumentationLocker);
    m_instrumentations = instrumentations;
    if (!instrumentations.empty())
    {
@@ -41,6 +54,44 @@ void Log::SetInstrumentations(const std::string& instrumentations)
             m_activeInstrumentations.insert(item);
       }
    }
+
+   for (auto& flag : m_instrumentationFlags)
+      flag.second->store(IsInstrumentationActive(flag.first), std::memory_order_relaxed);
+}
+
+const std::atomic<bool>& Log::GetInstrumentationFlag(std::string_view key)
+{
+   std::lock_guard<std::mutex> lock(m_instrumentationLocker);
+   auto it = m_instrumentationFlags.find(std::string(key));
+   if (it == m_instrumentationFlags.end())
+      it = m_instrumentationFlags.emplace(std::string(key), std::make_unique<std::atomic<bool>>(IsInstrumentationActive(key))).first;
+   return *it->second;
+}
+
+#ifndef DOF_DISABLE_INSTRUMENTATION
+bool Log::IsInstrumentationEnabled(std::string_view key) { return GetInstrumentationFlag(key).load(std::memory_order_relaxed); }
+#endif
+
+bool Log::IsInstrumentationActive(std::string_view key)
+{
+   if (m_activeInstrumentations.find("*") != m_activeInstrumentations.end())
+      return true;
+
+   // All comma separated parts of the key have to be active.
+   while (true)
+   {
+      size_t separator = key.find(',');
+      std::string_view keyItem = key.substr(0, separator);
+      size_t first = keyItem.find_first_not_of(" \t");
+      keyItem = first == std::string_view::npos ? std::string_view() : keyItem.substr(first, keyItem.find_last_not_of(" \t") - first + 1);
+      if (m_activeInstrumentations.find(std::string(keyItem)) == m_activeInstrumentations.end())
+         return false;
+      if (separator == std::string_view::npos)
+         return true;
+      key.remove_prefix(separator + 1);
+      if (key.empty())
+         return true;
+   }
 }
 
 void Log::Init(bool enableLogging)
@@ -91,20 +142,10 @@ void Log::Init(bool enableLogging)
          m_logger << "Original C# version: https://github.com/DirectOutput/DirectOutput" << std::endl;
          m_logger << "C++ port: https://github.com/jsm174/libdof" << std::endl;
 
-         auto nowMs = std::chrono::system_clock::now();
-         auto timeT = std::chrono::system_clock::to_time_t(nowMs);
-         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(nowMs.time_since_epoch()) % 1000;
-         std::stringstream timestamp;
-         struct tm localTime2;
-#ifdef _WIN32
-         localtime_s(&localTime2, &timeT);
-         timestamp << std::put_time(&localTime2, "%Y.%m.%d %H:%M:%S");
-#else
-         timestamp << std::put_time(localtime_r(&timeT, &localTime2), "%Y.%m.%d %H:%M:%S");
-#endif
-         timestamp << "." << std::setfill('0') << std::setw(3) << ms.count();
+         std::string timestamp;
+         AppendTimestamp(timestamp);
 
-         m_logger << timestamp.str() << "\t" << StringExtensions::Build("DirectOutput logger initialized{0}", instrumentationsEnabledNote) << std::endl;
+         m_logger << timestamp << "\t" << StringExtensions::Build("DirectOutput logger initialized{0}", instrumentationsEnabledNote) << std::endl;
 
          m_isOk = true;
 
@@ -117,6 +158,7 @@ void Log::Init(bool enableLogging)
          }
 
          m_logger.flush();
+         StartWriter();
       }
       catch (...)
       {
@@ -136,10 +178,19 @@ void Log::AfterInit() { m_preLogFileLog.clear(); }
 
 void Log::Finish()
 {
+   bool isOpen;
+   {
+      std::lock_guard<std::mutex> lock(m_locker);
+      isOpen = m_logger.is_open();
+   }
+   if (isOpen)
+      Write("Logging stopped");
+
+   StopWriter();
+
    std::lock_guard<std::mutex> lock(m_locker);
    if (m_logger.is_open())
    {
-      Write("Logging stopped");
       m_logger.flush();
       m_logger.close();
    }
@@ -148,8 +199,135 @@ void Log::Finish()
    m_isEnabled = true;
 }
 
-void Log::WriteRaw(const std::string& message)
+// Defined after the other members, so the writer is stopped before the queue and the log file are destroyed.
+Log::WriterGuard::~WriterGuard() { StopWriter(); }
+
+void Log::StartWriter()
 {
+   if (m_writerThread.joinable())
+      return;
+
+   if (!m_queue)
+      m_queue = std::make_unique<LogLineQueue>();
+   m_reportedDroppedLineCount = m_queue->GetDroppedCount();
+   m_flushRequested = false;
+   m_writerActive = true;
+   try
+   {
+      m_writerThread = std::thread(&Log::WriterThreadDoIt);
+   }
+   catch (...)
+   {
+      m_writerActive = false;
+   }
+}
+
+void Log::StopWriter()
+{
+   if (!m_writerThread.joinable())
+      return;
+
+   {
+      std::lock_guard<std::mutex> lock(m_writerMutex);
+      m_writerActive = false;
+   }
+   m_writerCondition.notify_one();
+   m_writerThread.join();
+
+   // Lines queued by threads which were just passing the active check are written here.
+   std::string batch;
+   WriteQueuedLines(batch);
+}
+
+void Log::WriterThreadDoIt()
+{
+   std::string batch;
+   bool active = true;
+   while (active)
+   {
+      {
+         std::unique_lock<std::mutex> lock(m_writerMutex);
+         m_writerCondition.wait_for(lock, std::chrono::milliseconds(WriterFlushIntervalMs), [] { return m_flushRequested.load() || !m_writerActive.load(); });
+         active = m_writerActive;
+      }
+      m_flushRequested = false;
+      WriteQueuedLines(batch);
+   }
+}
+
+void Log::WriteQueuedLines(std::string& batch)
+{
+   batch.clear();
+   std::string line;
+   while (m_queue->TryDequeue(line))
+   {
+      batch += line;
+      batch += '\n';
+   }
+
+   uint64_t droppedLineCount = m_queue->GetDroppedCount();
+   if (droppedLineCount != m_reportedDroppedLineCount)
+   {
+      AppendTimestamp(batch);
+      batch += StringExtensions::Build("\tWarning: {0} log lines were dropped because the log queue was full.\n", std::to_string(droppedLineCount - m_reportedDroppedLineCount));
+      m_reportedDroppedLineCount = droppedLineCount;
+   }
+
+   if (batch.empty())
+      return;
+
+   std::lock_guard<std::mutex> lock(m_locker);
+   if (m_isOk && m_logger.is_open())
+   {
+      try
+      {
+         m_logger.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+         m_logger.flush();
+      }
+      catch (...)
+      {
+      }
+   }
+}
+
+void Log::AppendTimestamp(std::string& line)
+{
+   // The date part only changes once per second, so it is formatted once and reused by all lines of that second.
+   thread_local std::time_t cachedTime = -1;
+   thread_local char cachedDate[32] = { 0 };
+
+   auto now = std::chrono::system_clock::now();
+   std::time_t timeT = std::chrono::system_clock::to_time_t(now);
+   int ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+   if (timeT != cachedTime)
+   {
+      struct tm localTime;
+#ifdef _WIN32
+      localtime_s(&localTime, &timeT);
+#else
+      localtime_r(&timeT, &localTime);
+#endif
+      std::strftime(cachedDate, sizeof(cachedDate), "%Y.%m.%d %H:%M:%S", &localTime);
+      cachedTime = timeT;
+   }
+
+   char msText[5] = { '.', static_cast<char>('0' + ms / 100), static_cast<char>('0' + ms / 10 % 10), static_cast<char>('0' + ms % 10), 0 };
+   line += cachedDate;
+   line += msText;
+}
+
+void Log::WriteRaw(std::string&& line, bool flush)
+{
+   if (m_writerActive.load(std::memory_order_acquire))
+   {
+      if (m_queue->Enqueue(std::move(line)) && (flush || m_queue->Count() > static_cast<int>(LogLineQueue::Capacity / 2)))
+      {
+         m_flushRequested = true;
+         m_writerCondition.notify_one();
+      }
+      return;
+   }
+
    std::lock_guard<std::mutex> lock(m_locker);
    if (!m_isEnabled)
       return;
@@ -158,7 +336,7 @@ void Log::WriteRaw(const std::string& message)
    {
       try
       {
-         m_logger << message << std::endl;
+         m_logger << line << '\n';
          m_logger.flush();
       }
       catch (...)
@@ -167,7 +345,7 @@ void Log::WriteRaw(const std::string& message)
    }
    else if (!m_isInitialized)
    {
-      m_preLogFileLog.push_back(message);
+      m_preLogFileLog.push_back(std::move(line));
    }
 }
 
@@ -177,66 +355,51 @@ void Log::Write(const std::string& message)
    WriteToFile(message);
 }
 
-void Log::WriteToFile(const std::string& message)
+void Log::WriteToFile(const std::string& message, bool flush)
 {
    if (StringExtensions::IsNullOrWhiteSpace(message))
    {
-      auto nowMs = std::chrono::system_clock::now();
-      auto timeT = std::chrono::system_clock::to_time_t(nowMs);
-      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(nowMs.time_since_epoch()) % 1000;
-      std::stringstream timestamp;
-      struct tm localTime3;
-#ifdef _WIN32
-      localtime_s(&localTime3, &timeT);
-      timestamp << std::put_time(&localTime3, "%Y.%m.%d %H:%M:%S");
-#else
-      timestamp << std::put_time(localtime_r(&timeT, &localTime3), "%Y.%m.%d %H:%M:%S");
-#endif
-      timestamp << "." << std::setfill('0') << std::setw(3) << ms.count();
-      WriteRaw(timestamp.str() + "\t");
+      std::string line;
+      AppendTimestamp(line);
+      line += '\t';
+      WriteRaw(std::move(line), flush);
+      return;
    }
-   else
+
+   std::string_view remaining = message;
+   while (!remaining.empty())
    {
-      std::stringstream ss(message);
+      size_t lineEnd = remaining.find('\n');
+      std::string_view text = remaining.substr(0, lineEnd);
+      remaining = lineEnd == std::string_view::npos ? std::string_view() : remaining.substr(lineEnd + 1);
+      if (!text.empty() && text.back() == '\r')
+         text.remove_suffix(1);
+
       std::string line;
-      while (std::getline(ss, line))
-      {
-         if (!line.empty() && line.back() == '\r')
-            line.pop_back();
-
-         auto nowMs = std::chrono::system_clock::now();
-         auto timeT = std::chrono::system_clock::to_time_t(nowMs);
-         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(nowMs.time_since_epoch()) % 1000;
-         std::stringstream timestamp;
-         struct tm localTime4;
-#ifdef _WIN32
-         localtime_s(&localTime4, &timeT);
-         timestamp << std::put_time(&localTime4, "%Y.%m.%d %H:%M:%S");
-#else
-         timestamp << std::put_time(localtime_r(&timeT, &localTime4), "%Y.%m.%d %H:%M:%S");
-#endif
-         timestamp << "." << std::setfill('0') << std::setw(3) << ms.count();
-         WriteRaw(timestamp.str() + "\t" + line);
-      }
+      line.reserve(24 + text.size());
+      AppendTimestamp(line);
+      line += '\t';
+      line += text;
+      WriteRaw(std::move(line), flush);
    }
 }
 
 void Log::Error(const std::string& message)
 {
    ::DOF::Log(DOF_LogLevel_ERROR, "%s", message.c_str());
-   WriteToFile(StringExtensions::Build("Error: {0}", message));
+   WriteToFile(StringExtensions::Build("Error: {0}", message), true);
 }
 
 void Log::Warning(const std::string& message)
 {
    ::DOF::Log(DOF_LogLevel_WARN, "%s", message.c_str());
-   WriteToFile(StringExtensions::Build("Warning: {0}", message));
+   WriteToFile(StringExtensions::Build("Warning: {0}", message), true);
 }
 
 void Log::Exception(const std::string& message)
 {
    ::DOF::Log(DOF_LogLevel_ERROR, "%s", message.c_str());
-   WriteToFile(StringExtensions::Build("EXCEPTION: {0}", message));
+   WriteToFile(StringExtensions::Build("EXCEPTION: {0}", message), true);
 }
 
 void Log::Debug(const std::string& message)
@@ -256,24 +419,7 @@ void Log::Once(const std::string& key, const std::string& message)
 
 void Log::Instrumentation(const std::string& key, const std::string& message)
 {
-   bool writeMessage = m_activeInstrumentations.find("*") != m_activeInstrumentations.end();
-   if (!writeMessage)
-   {
-      std::stringstream ss(key);
-      std::string keyItem;
-      bool allKeysFound = true;
-
-      while (std::getline(ss, keyItem, ',') && allKeysFound)
-      {
-         keyItem.erase(0, keyItem.find_first_not_of(" \t"));
-         keyItem.erase(keyItem.find_last_not_of(" \t") + 1);
-         if (m_activeInstrumentations.find(keyItem) == m_activeInstrumentations.end())
-            allKeysFound = false;
-      }
-      writeMessage = allKeysFound;
-   }
-
-   if (writeMessage)
+   if (IsInstrumentationEnabled(key))
    {
       ::DOF::Log(DOF_LogLevel_DEBUG, "%s", message.c_str());
       WriteToFile(StringExtensions::Build("Debug [{0}]: {1}", key, message));
@@ -1,10 +1,31 @@
 #pragma once
 
 #include "DOF/DOF.h"
+#include "LogLineQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <fstream>
 #include <mutex>
+#include <thread>
+
+// Writes an instrumentation message only if the key is active. The message expression is not evaluated otherwise.
+// The key has to be the same for every call at a given place, since its enabled flag is looked up once and cached there.
+#ifdef DOF_DISABLE_INSTRUMENTATION
+#define DOF_INSTRUMENTATION(key, message) ((void)0)
+#else
+#define DOF_INSTRUMENTATION(key, message) \
+   do \
+   { \
+      static const std::atomic<bool>& dofInstrumentationEnabled = ::DOF::Log::GetInstrumentationFlag(key); \
+      if (dofInstrumentationEnabled.load(std::memory_order_relaxed)) \
+         ::DOF::Log::Instrumentation(key, message); \
+   } while (0)
+#endif
 
 namespace DOF
 {
@@ -28,13 +49,26 @@ public:
    static void Debug(const std::string& message);
    static void Once(const std::string& key, const std::string& message);
    static void Instrumentation(const std::string& key, const std::string& message);
+   static const std::atomic<bool>& GetInstrumentationFlag(std::string_view key);
+#ifdef DOF_DISABLE_INSTRUMENTATION
+   static bool IsInstrumentationEnabled(std::string_view key) { return false; }
+#else
+   static bool IsInstrumentationEnabled(std::string_view key);
+#endif
+   static uint64_t GetDroppedLineCount() { return m_queue ? m_queue->GetDroppedCount() : 0; }
 
 private:
    Log();
    ~Log() { };
 
-   static void WriteRaw(const std::string& message);
-   static void WriteToFile(const std::string& message);
+   static void WriteRaw(std::string&& line, bool flush = false);
+   static void WriteToFile(const std::string& message, bool flush = false);
+   static void AppendTimestamp(std::string& line);
+   static void StartWriter();
+   static void StopWriter();
+   static void WriterThreadDoIt();
+   static void WriteQueuedLines(std::string& batch);
+   static bool IsInstrumentationActive(std::string_view key);
 
    static std::ofstream m_logger;
    static bool m_isInitialized;
@@ -42,9 +76,27 @@ private:
    static bool m_isEnabled;
    static std::mutex m_locker;
 
+   // Once the log file is open, lines are queued and written in batches by a background thread, so callers never wait for the disk.
+   static const int WriterFlushIntervalMs = 100;
+   static std::unique_ptr<LogLineQueue> m_queue;
+   static std::thread m_writerThread;
+   static std::atomic<bool> m_writerActive;
+   static std::atomic<bool> m_flushRequested;
+   static std::mutex m_writerMutex;
+   static std::condition_variable m_writerCondition;
+   static uint64_t m_reportedDroppedLineCount;
+
+   struct WriterGuard
+   {
+      ~WriterGuard();
+   };
+   static WriterGuard m_writerGuard;
+
    static std::string m_filename;
    static std::string m_instrumentations;
    static std::unordered_set<std::string> m_activeInstrumentations;
+   static std::unordered_map<std::string, std::unique_ptr<std::atomic<bool>>> m_instrumentationFlags;
+   static std::mutex m_instrumentationLocker;
    static std::vector<std::string> m_preLogFileLog;
    static std::unordered_set<std::string> m_onceKeys;
 };
@@ -0,0 +1,72 @@
+#include "LogLineQueue.h"
+
+#include <utility>
+
+namespace DOF
+{
+
+LogLineQueue::LogLineQueue()
+   : m_buffer(new Cell[Capacity])
+   , m_enqueuePos(0)
+   , m_dequeuePos(0)
+   , m_droppedCount(0)
+{
+   for (size_t i = 0; i < Capacity; i++)
+      m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+LogLineQueue::~LogLineQueue() { delete[] m_buffer; }
+
+bool LogLineQueue::Enqueue(std::string&& line)
+{
+   size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+   Cell* cell;
+
+   while (true)
+   {
+      cell = &m_buffer[pos & (Capacity - 1)];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0)
+      {
+         if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+      }
+      else if (diff < 0)
+      {
+         m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+         return false;
+      }
+      else
+      {
+         pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+   }
+
+   cell->line = std::move(line);
+   cell->sequence.store(pos + 1, std::memory_order_release);
+   return true;
+}
+
+bool LogLineQueue::TryDequeue(std::string& line)
+{
+   size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+   Cell* cell = &m_buffer[pos & (Capacity - 1)];
+   if (cell->sequence.load(std::memory_order_acquire) != pos + 1)
+      return false;
+
+   line = std::move(cell->line);
+   cell->line.clear();
+   cell->sequence.store(pos + Capacity, std::memory_order_release);
+   m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+   return true;
+}
+
+int LogLineQueue::Count() const
+{
+   size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+   size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+   return enqueuePos > dequeuePos ? static_cast<int>(enqueuePos - dequeuePos) : 0;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace DOF
+{
+
+// Bounded multi producer, single consumer ring of formatted log lines. Enqueue never blocks,
+// a line which does not fit into the queue is dropped and counted.
+class LogLineQueue
+{
+public:
+   LogLineQueue();
+   ~LogLineQueue();
+
+   bool Enqueue(std::string&& line);
+   bool TryDequeue(std::string& line);
+   int Count() const;
+   uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+   static const size_t Capacity = 16384;
+
+private:
+   struct Cell
+   {
+      std::atomic<size_t> sequence;
+      std::string line;
+   };
+
+   Cell* m_buffer;
+   alignas(64) std::atomic<size_t> m_enqueuePos;
+   alignas(64) std::atomic<size_t> m_dequeuePos;
+   std::atomic<uint64_t> m_droppedCount;
+};
+
+}
\ No newline at end of file
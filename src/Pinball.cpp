@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstring>
 #include <filesystem>
+#include <vector>
 
 #include "Log.h"
 #include "Logger.h"
@@ -12,13 +13,25 @@
 #include "cab/ICabinetOwner.h"
 #include "cab/CabinetOwner.h"
 #include "cab/out/OutputControllerList.h"
+#include "cab/out/OutputUpdateExecutor.h"
 #include "cab/overrides/TableOverrideSettings.h"
 #include "cab/toys/ToyList.h"
 #include "globalconfiguration/GlobalConfig.h"
 #include "pinballsupport/AlarmHandler.h"
 #include "pinballsupport/InputQueue.h"
 #include "table/Table.h"
+#include "table/TableElement.h"
 #include "table/TableElementData.h"
+#include "table/TableElementList.h"
+#include "fx/AssignedEffectList.h"
+#include "fx/EffectEffectBase.h"
+#include "fx/listfx/ListEffect.h"
+#include "fx/timmedfx/BlinkEffect.h"
+#include "fx/timmedfx/DelayEffect.h"
+#include "fx/timmedfx/DurationEffect.h"
+#include "fx/timmedfx/ExtendDurationEffect.h"
+#include "fx/timmedfx/MaxDurationEffect.h"
+#include "fx/timmedfx/MinDurationEffect.h"
 #include "ledcontrol/loader/LedControlConfigList.h"
 #include "ledcontrol/loader/LedControlConfig.h"
 #include "ledcontrol/setup/Configurator.h"
@@ -33,13 +46,18 @@ Pinball::Pinball()
    , m_alarms(new AlarmHandler())
    , m_globalConfig(new GlobalConfig())
    , m_inputQueue(new InputQueue())
+   , m_setupComplete(false)
+   , m_setupFailed(false)
    , m_keepMainThreadAlive(false)
    , m_mainThreadDoWork(false)
+   , m_mainThreadWaiting(false)
 {
 }
 
 Pinball::~Pinball()
 {
+   FinishSetupThread();
+
    delete m_table;
    delete m_cabinet;
    delete m_alarms;
@@ -233,10 +251,39 @@ void Pinball::Setup(const std::string& globalConfigFileName, const std::string&
             std::unordered_map<int, FileInfo> ledControlIniFiles = m_globalConfig->GetIniFilesDictionary(tableFilename);
 
             LedControlConfigList* l = new LedControlConfigList();
+            if (m_globalConfig->IsLazyLedControlParsing())
+               l->SetRomNameFilter(romName);
+            if (m_globalConfig->IsLedControlConfigCache())
+            {
+               std::string cacheDirectory = m_globalConfig->GlobalConfigDirectoryName();
+               if (!cacheDirectory.empty())
+               {
+                  if (l->GetRomNameFilter().empty())
+                     Log::Write("LedControlConfigCache is enabled. LedControl files will be parsed lazily for the current RomName only.");
+                  l->SetRomNameFilter(romName);
+                  l->SetCacheDirectory(cacheDirectory);
+               }
+               else
+               {
+                  Log::Warning("LedControlConfigCache is enabled, but no global config directory is available. LedControl files will not be cached.");
+               }
+            }
             if (ledControlIniFiles.size() > 0)
             {
+               auto loadStart = std::chrono::steady_clock::now();
                l->LoadLedControlFiles(ledControlIniFiles, false);
-               Log::Write(StringExtensions::Build("{0} directoutputconfig.ini or ledcontrol.ini files loaded.", std::to_string(ledControlIniFiles.size())));
+               auto loadMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadStart).count();
+               std::string loadMode = !l->GetRomNameFilter().empty() ? "lazy parsing" : "full parsing";
+               if (!l->GetCacheDirectory().empty())
+               {
+                  if (l->GetCacheHitCount() == static_cast<int>(ledControlIniFiles.size()))
+                     loadMode = "config cache hit";
+                  else if (l->GetCacheHitCount() == 0)
+                     loadMode = "config cache miss, lazy parsing";
+                  else
+                     loadMode = StringExtensions::Build("config cache hit for {0} of {1} files, lazy parsing", std::to_string(l->GetCacheHitCount()), std::to_string(ledControlIniFiles.size()));
+               }
+               Log::Write(StringExtensions::Build("{0} directoutputconfig.ini or ledcontrol.ini files loaded in {1}ms ({2}).", std::to_string(ledControlIniFiles.size()), std::to_string(loadMs), loadMode));
             }
             else
             {
@@ -254,6 +301,7 @@ void Pinball::Setup(const std::string& globalConfigFileName, const std::string&
                Configurator* c = new Configurator();
                c->SetEffectMinDurationMs(m_globalConfig->GetLedControlMinimumEffectDurationMs());
                c->SetEffectRGBMinDurationMs(m_globalConfig->GetLedControlMinimumRGBEffectDurationMs());
+               c->SetReplaceValues(m_globalConfig->GetReplaceValuesDictionary());
                c->Setup(l, m_table, m_cabinet, romName);
                delete c;
 
@@ -322,6 +370,8 @@ void Pinball::Init()
    {
       Log::Write("Starting processes");
 
+      OutputUpdateExecutor::GetInstance().SetWorkerCount(m_globalConfig->GetOutputUpdateWorkerThreads());
+
       CabinetOwner* co = new CabinetOwner();
       co->SetAlarms(m_alarms);
       co->GetConfigurationSettings().emplace("LedControlMinimumEffectDurationMs", std::to_string(m_globalConfig->GetLedControlMinimumEffectDurationMs()));
@@ -330,11 +380,13 @@ void Pinball::Init()
       m_cabinet->Init(co);
       delete co;
 
+      m_alarms->SetFrameIntervalMs(1000 / m_globalConfig->GetEffectFrameRate());
       m_table->Init(this);
       m_alarms->Init(this);
       m_table->TriggerStaticEffects();
       m_cabinet->Update();
 
+      InitInputCoalescing();
       InitMainThread();
       Log::Write("Framework initialized.");
       Log::Write("Have fun! :)");
@@ -351,8 +403,12 @@ void Pinball::Finish()
    try
    {
       Log::Write("Finishing framework");
+      FinishSetupThread();
       FinishMainThread();
 
+      if (m_inputQueue->IsCoalescing())
+         Log::Write(StringExtensions::Build("Input coalescing merged {0} table element updates.", std::to_string(m_inputQueue->GetCoalescedCount())));
+
       m_alarms->Finish();
       m_table->Finish();
       m_cabinet->Finish();
@@ -367,6 +423,59 @@ void Pinball::Finish()
    }
 }
 
+void Pinball::InitInputCoalescing()
+{
+   m_inputQueue->SetCoalescing(m_globalConfig->IsInputCoalescing());
+   if (!m_inputQueue->IsCoalescing())
+      return;
+
+   int keepAllEdgesCount = 0;
+   for (TableElement* tableElement : *m_table->GetTableElements())
+   {
+      bool keepAllEdges = false;
+      for (AssignedEffect* assignedEffect : *tableElement->GetAssignedEffects())
+         keepAllEdges |= RequiresAllEdges(assignedEffect->GetEffect());
+
+      if (!keepAllEdges)
+         continue;
+
+      if (tableElement->GetTableElementType() == TableElementTypeEnum::NamedElement)
+         m_inputQueue->SetKeepAllEdges(tableElement->GetName(), true);
+      else
+         m_inputQueue->SetKeepAllEdges(tableElement->GetTableElementType(), tableElement->GetNumber(), true);
+      keepAllEdgesCount++;
+   }
+
+   Log::Write(StringExtensions::Build("Input coalescing enabled. {0} table elements keep every on/off transition.", std::to_string(keepAllEdgesCount)));
+}
+
+bool Pinball::RequiresAllEdges(IEffect* effect, int depth)
+{
+   if (effect == nullptr || depth > 32)
+      return false;
+
+   // Timed effects react to every on/off transition of the trigger value, even if it is reverted within the same frame.
+   if (dynamic_cast<BlinkEffect*>(effect) || dynamic_cast<DurationEffect*>(effect) || dynamic_cast<MinDurationEffect*>(effect) || dynamic_cast<MaxDurationEffect*>(effect)
+      || dynamic_cast<ExtendDurationEffect*>(effect) || dynamic_cast<DelayEffect*>(effect))
+      return true;
+
+   EffectEffectBase* effectEffect = dynamic_cast<EffectEffectBase*>(effect);
+   if (effectEffect != nullptr)
+      return RequiresAllEdges(effectEffect->GetTargetEffect(), depth + 1);
+
+   ListEffect* listEffect = dynamic_cast<ListEffect*>(effect);
+   if (listEffect != nullptr)
+   {
+      for (AssignedEffect* assignedEffect : listEffect->GetAssignedEffects())
+      {
+         if (RequiresAllEdges(assignedEffect->GetEffect(), depth + 1))
+            return true;
+      }
+   }
+
+   return false;
+}
+
 void Pinball::InitMainThread()
 {
    if (!IsMainThreadActive())
@@ -384,6 +493,39 @@ void Pinball::InitMainThread()
    }
 }
 
+void Pinball::SetupAsync(const std::string& globalConfigFileName, const std::string& tableFilename, const std::string& romName)
+{
+   FinishSetupThread();
+
+   // Table element data received meanwhile stays in the input queue until the main thread is started by Init.
+   m_setupComplete = false;
+   m_setupFailed = false;
+   m_setupThread = std::thread(
+      [this, globalConfigFileName, tableFilename, romName]()
+      {
+         auto setupStart = std::chrono::steady_clock::now();
+         try
+         {
+            Setup(globalConfigFileName, tableFilename, romName);
+            Init();
+            auto setupMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - setupStart).count();
+            Log::Write(StringExtensions::Build("Background setup completed in {0}ms", std::to_string(setupMs)));
+         }
+         catch (const std::exception& e)
+         {
+            Log::Exception(StringExtensions::Build("DirectOutput framework background setup failed: {0}", e.what()));
+            m_setupFailed = true;
+         }
+         m_setupComplete = true;
+      });
+}
+
+void Pinball::FinishSetupThread()
+{
+   if (m_setupThread.joinable())
+      m_setupThread.join();
+}
+
 void Pinball::FinishMainThread()
 {
    if (m_mainThread.joinable())
@@ -413,30 +555,53 @@ void Pinball::MainThreadSignal()
    m_mainThreadCV.notify_one();
 }
 
+void Pinball::MainThreadSignalInput()
+{
+   // The input queue is lock free, so only take the main thread mutex when the main thread is waiting.
+   // Otherwise it will find the new input when it checks the queue before waiting again.
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (m_mainThreadWaiting)
+      MainThreadSignal();
+}
+
 void Pinball::MainThreadDoIt()
 {
    try
    {
+      int inputDataBatchSize = m_inputQueue->IsCoalescing() ? INPUT_DATA_COALESCING_BATCH_SIZE : INPUT_DATA_BATCH_SIZE;
+      std::vector<TableElementData> inputData;
+      inputData.reserve(inputDataBatchSize);
+      uint64_t droppedInputCount = 0;
+
       while (m_keepMainThreadAlive)
       {
          bool updateRequired = false;
          auto start = std::chrono::steady_clock::now();
 
-         while (m_inputQueue->Count() > 0 && std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() <= MAX_INPUT_DATA_PROCESSING_TIME_MS
+         while (!m_inputQueue->IsEmpty() && std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() <= MAX_INPUT_DATA_PROCESSING_TIME_MS
             && m_keepMainThreadAlive)
          {
-            try
-            {
-               TableElementData data = m_inputQueue->Dequeue();
-               m_table->UpdateTableElement(&data);
-               updateRequired = true;
-            }
-            catch (const std::exception& e)
+            m_inputQueue->DequeueBatch(inputData, inputDataBatchSize);
+            for (TableElementData& data : inputData)
             {
-               Log::Exception(StringExtensions::Build("An unhandled exception occured while processing table element data: {0}", e.what()));
+               try
+               {
+                  m_table->UpdateTableElement(&data);
+                  updateRequired = true;
+               }
+               catch (const std::exception& e)
+               {
+                  Log::Exception(StringExtensions::Build("An unhandled exception occured while processing table element data: {0}", e.what()));
+               }
             }
          }
 
+         if (m_inputQueue->GetDroppedCount() != droppedInputCount)
+         {
+            droppedInputCount = m_inputQueue->GetDroppedCount();
+            Log::Warning(StringExtensions::Build("Input queue is full. {0} table element updates have been dropped so far.", std::to_string(droppedInputCount)));
+         }
+
          if (m_keepMainThreadAlive)
          {
             try
@@ -468,17 +633,20 @@ void Pinball::MainThreadDoIt()
             auto now = std::chrono::steady_clock::now();
 
             std::unique_lock<std::mutex> lock(m_mainThreadMutex);
+            m_mainThreadWaiting = true;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
 
-            while (m_inputQueue->Count() == 0 && nextAlarm > now && !m_mainThreadDoWork && m_keepMainThreadAlive)
+            while (m_inputQueue->IsEmpty() && nextAlarm > now && !m_mainThreadDoWork && m_keepMainThreadAlive)
             {
                long timeoutMs = std::chrono::duration_cast<std::chrono::milliseconds>(nextAlarm - now).count();
                timeoutMs = std::max(1L, std::min(timeoutMs, 50L));
 
-               m_mainThreadCV.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return m_inputQueue->Count() > 0 || m_mainThreadDoWork || !m_keepMainThreadAlive; });
+               m_mainThreadCV.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return !m_inputQueue->IsEmpty() || m_mainThreadDoWork || !m_keepMainThreadAlive; });
 
                now = std::chrono::steady_clock::now();
                nextAlarm = m_alarms->GetNextAlarmTime();
             }
+            m_mainThreadWaiting = false;
             m_mainThreadDoWork = false;
          }
       }
@@ -492,19 +660,19 @@ void Pinball::MainThreadDoIt()
 void Pinball::ReceiveData(char type, int number, int value)
 {
    m_inputQueue->Enqueue(type, number, value);
-   MainThreadSignal();
+   MainThreadSignalInput();
 }
 
 void Pinball::ReceiveData(const std::string& tableElementName, int value)
 {
    m_inputQueue->Enqueue(tableElementName, value);
-   MainThreadSignal();
+   MainThreadSignalInput();
 }
 
 void Pinball::ReceiveData(const TableElementData& tableElementData)
 {
    m_inputQueue->Enqueue(tableElementData);
-   MainThreadSignal();
+   MainThreadSignalInput();
 }
 
 }
@@ -17,6 +17,7 @@ class AlarmHandler;
 class GlobalConfig;
 class InputQueue;
 class TableElementData;
+class IEffect;
 
 class Pinball
 {
@@ -33,6 +34,9 @@ public:
    const GlobalConfig* GetGlobalConfig() const { return m_globalConfig; }
    void Setup(const std::string& globalConfigFileName = "", const std::string& tableFilename = "", const std::string& romName = "");
    void Init();
+   void SetupAsync(const std::string& globalConfigFileName = "", const std::string& tableFilename = "", const std::string& romName = "");
+   bool IsSetupComplete() const { return !m_setupThread.joinable() || m_setupComplete; }
+   bool IsSetupFailed() const { return m_setupFailed; }
    void Finish();
    void MainThreadSignal();
    bool IsMainThreadActive() const { return m_mainThread.joinable(); }
@@ -44,9 +48,13 @@ private:
    void SetAlarms(AlarmHandler* alarms) { m_alarms = alarms; }
    void SetGlobalConfig(GlobalConfig* globalConfig) { m_globalConfig = globalConfig; }
 
+   void FinishSetupThread();
    void InitMainThread();
    void FinishMainThread();
    void MainThreadDoIt();
+   void MainThreadSignalInput();
+   void InitInputCoalescing();
+   static bool RequiresAllEdges(IEffect* effect, int depth = 0);
 
    Cabinet* m_cabinet;
    Table* m_table;
@@ -54,13 +62,20 @@ private:
    GlobalConfig* m_globalConfig;
    InputQueue* m_inputQueue;
 
+   std::thread m_setupThread;
+   std::atomic<bool> m_setupComplete;
+   std::atomic<bool> m_setupFailed;
+
    std::thread m_mainThread;
    std::mutex m_mainThreadMutex;
    std::condition_variable m_mainThreadCV;
    std::atomic<bool> m_keepMainThreadAlive;
    std::atomic<bool> m_mainThreadDoWork;
+   std::atomic<bool> m_mainThreadWaiting;
 
    static const int MAX_INPUT_DATA_PROCESSING_TIME_MS = 10;
+   static const int INPUT_DATA_BATCH_SIZE = 32;
+   static const int INPUT_DATA_COALESCING_BATCH_SIZE = 1024;
 };
 
 }
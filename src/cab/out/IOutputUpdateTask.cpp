@@ -0,0 +1,6 @@
+#include "IOutputUpdateTask.h"
+
+namespace DOF
+{
+
+}
\ No newline at end of file
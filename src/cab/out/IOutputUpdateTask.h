@@ -0,0 +1,17 @@
+#pragma once
+
+#include <chrono>
+
+namespace DOF
+{
+
+class IOutputUpdateTask
+{
+public:
+   IOutputUpdateTask() { }
+   virtual ~IOutputUpdateTask() { }
+
+   virtual std::chrono::steady_clock::time_point RunOutputUpdate() = 0;
+};
+
+}
\ No newline at end of file
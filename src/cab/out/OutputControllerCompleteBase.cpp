@@ -1,5 +1,6 @@
 #include "OutputControllerCompleteBase.h"
 #include "Output.h"
+#include "OutputUpdateExecutor.h"
 #include "../../Log.h"
 #include "../../general/StringExtensions.h"
 #include <algorithm>
@@ -14,6 +15,20 @@ OutputControllerCompleteBase::OutputControllerCompleteBase()
    : m_updateRequired(false)
    , m_inUseState(InUseState::Startup)
    , m_keepUpdaterThreadAlive(false)
+   , m_updaterTaskState(UpdaterTaskState::Inactive)
+   , m_fullUpdateRequired(true)
+   , m_commandDeferred(false)
+   , m_waitForCommandSlot(false)
+   , m_sentFrameCount(0)
+   , m_droppedFrameCount(0)
+   , m_totalLatencyUs(0)
+   , m_maxLatencyUs(0)
+   , m_valueBufferGenerations { 0, 0, 0 }
+   , m_middleBuffer(1)
+   , m_backBuffer(0)
+   , m_frontBuffer(2)
+   , m_generation(0)
+   , m_sentGeneration(0)
 {
 }
 
@@ -48,12 +63,125 @@ void OutputControllerCompleteBase::Finish()
 {
    FinishUpdaterThread();
    Log::Write(StringExtensions::Build("{0} {1} finished and updater thread stopped.", GetXmlElementName(), GetName()));
+   LogUpdateStatistics();
+}
+
+int64_t OutputControllerCompleteBase::GetAverageLatencyUs() const
+{
+   uint64_t sentFrameCount = m_sentFrameCount;
+   return sentFrameCount > 0 ? m_totalLatencyUs / static_cast<int64_t>(sentFrameCount) : 0;
+}
+
+void OutputControllerCompleteBase::LogUpdateStatistics() const
+{
+   if (m_sentFrameCount == 0 && m_droppedFrameCount == 0)
+      return;
+
+   Log::Write(StringExtensions::Build("{0} {1} sent {2} frames, {3} frames were superseded before they could be sent",
+      { GetXmlElementName(), GetName(), std::to_string(m_sentFrameCount), std::to_string(m_droppedFrameCount) }));
+   Log::Write(StringExtensions::Build("{0} {1} update latency: average {2} us, max {3} us", { GetXmlElementName(), GetName(), std::to_string(GetAverageLatencyUs()), std::to_string(m_maxLatencyUs) }));
+}
+
+void OutputControllerCompleteBase::SetMinCommandInterval(std::chrono::steady_clock::duration interval, int burst) { m_commandBucket.Configure(interval, burst); }
+
+bool OutputControllerCompleteBase::TryAcquireCommandSlot()
+{
+   auto now = std::chrono::steady_clock::now();
+   if (m_commandBucket.TryConsume(now))
+      return true;
+
+   // Turning the outputs off on disconnect must not be deferred, since there is no later update to pick it up.
+   if (m_waitForCommandSlot)
+   {
+      std::this_thread::sleep_until(m_commandBucket.GetNextTokenTime());
+      return m_commandBucket.TryConsume(std::chrono::steady_clock::now());
+   }
+
+   m_commandDeferred = true;
+   return false;
+}
+
+std::chrono::steady_clock::time_point OutputControllerCompleteBase::GetNextSendTime() const
+{
+   return m_commandDeferred ? m_commandBucket.GetNextTokenTime() : std::chrono::steady_clock::time_point::max();
 }
 
 void OutputControllerCompleteBase::Update()
 {
    if (m_updateRequired)
+   {
+      PublishOutputValues();
       UpdaterThreadSignal();
+   }
+}
+
+void OutputControllerCompleteBase::AddChangedRange(int first, int count)
+{
+   if (!m_changedRanges.empty())
+   {
+      OutputValueRange& last = m_changedRanges.back();
+      if (first <= last.first + last.count && first + count >= last.first)
+      {
+         int end = std::max(last.first + last.count, first + count);
+         last.first = std::min(last.first, first);
+         last.count = end - last.first;
+         return;
+      }
+   }
+
+   if (static_cast<int>(m_changedRanges.size()) >= MaxChangedRanges)
+   {
+      int start = first;
+      int end = first + count;
+      for (const OutputValueRange& range : m_changedRanges)
+      {
+         start = std::min(start, range.first);
+         end = std::max(end, range.first + range.count);
+      }
+      m_changedRanges.clear();
+      m_changedRanges.push_back({ start, end - start });
+      return;
+   }
+
+   m_changedRanges.push_back({ first, count });
+}
+
+void OutputControllerCompleteBase::PublishOutputValues()
+{
+   std::lock_guard<std::mutex> lock(m_valueChangeMutex);
+
+   m_updateRequired = false;
+   m_valueBuffers[m_backBuffer].assign(m_outputValues.begin(), m_outputValues.end());
+   m_valueBufferGenerations[m_backBuffer] = ++m_generation;
+   m_valueBufferTimes[m_backBuffer] = std::chrono::steady_clock::now();
+   std::swap(m_valueBufferRanges[m_backBuffer], m_changedRanges);
+   m_changedRanges.clear();
+
+   m_backBuffer = m_middleBuffer.exchange(m_backBuffer | FreshBufferFlag, std::memory_order_acq_rel) & BufferIndexMask;
+}
+
+const std::vector<uint8_t>& OutputControllerCompleteBase::AcquireOutputValues(uint64_t& generation, const std::vector<OutputValueRange>*& changedRanges)
+{
+   if (m_middleBuffer.load(std::memory_order_relaxed) & FreshBufferFlag)
+      m_frontBuffer = m_middleBuffer.exchange(m_frontBuffer, std::memory_order_acq_rel) & BufferIndexMask;
+
+   generation = m_valueBufferGenerations[m_frontBuffer];
+   changedRanges = &m_valueBufferRanges[m_frontBuffer];
+   return m_valueBuffers[m_frontBuffer];
+}
+
+const std::vector<OutputControllerCompleteBase::OutputValueRange>& OutputControllerCompleteBase::GetFullRange(size_t size)
+{
+   if (m_fullRange.empty() || m_fullRange[0].count != static_cast<int>(size))
+      m_fullRange.assign(1, { 0, static_cast<int>(size) });
+   return m_fullRange;
+}
+
+const std::vector<uint8_t>& OutputControllerCompleteBase::GetZeroValues(size_t size)
+{
+   if (m_zeroValues.size() != size)
+      m_zeroValues.assign(size, 0);
+   return m_zeroValues;
 }
 
 void OutputControllerCompleteBase::SetValues(int firstOutput, const uint8_t* values, int valueCount)
@@ -73,6 +201,7 @@ void OutputControllerCompleteBase::SetValues(int firstOutput, const uint8_t* val
    if (copyLength > 0)
    {
       std::memcpy(&m_outputValues[firstOutput], values, copyLength);
+      AddChangedRange(firstOutput, copyLength);
 
       if (m_inUseState == InUseState::Startup)
          m_inUseState = InUseState::ValueChanged;
@@ -203,10 +332,9 @@ void OutputControllerCompleteBase::OnOutputValueChanged(IOutput* output)
             m_inUseState = InUseState::ValueChanged;
 
          m_outputValues[outputNumber - 1] = outputValue;
+         AddChangedRange(outputNumber - 1, 1);
 
          m_updateRequired = true;
-
-         UpdaterThreadSignal();
       }
    }
 }
@@ -215,6 +343,14 @@ void OutputControllerCompleteBase::InitUpdaterThread()
 {
    if (!IsUpdaterThreadActive())
    {
+      OutputUpdateExecutor& executor = OutputUpdateExecutor::GetInstance();
+      if (!executor.IsThreadPerDevice())
+      {
+         m_updaterTaskState = UpdaterTaskState::Connecting;
+         executor.Register(this);
+         return;
+      }
+
       m_keepUpdaterThreadAlive = true;
       m_updaterThreadFinished = false;
       try
@@ -231,6 +367,15 @@ void OutputControllerCompleteBase::InitUpdaterThread()
 
 void OutputControllerCompleteBase::FinishUpdaterThread()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Unregister(this);
+      if (m_updaterTaskState != UpdaterTaskState::Connecting && m_updaterTaskState != UpdaterTaskState::Stopped)
+         DisconnectUpdater();
+      m_updaterTaskState = UpdaterTaskState::Inactive;
+      return;
+   }
+
    if (m_updaterThread && m_updaterThread->joinable())
    {
       m_keepUpdaterThreadAlive = false;
@@ -255,117 +400,216 @@ void OutputControllerCompleteBase::FinishUpdaterThread()
 
 void OutputControllerCompleteBase::UpdaterThreadSignal()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Signal(this);
+      return;
+   }
+
    std::lock_guard<std::mutex> lock(m_conditionMutex);
    m_updateCondition.notify_one();
 }
 
-bool OutputControllerCompleteBase::IsUpdaterThreadActive() const { return m_updaterThread && m_updaterThread->joinable(); }
+bool OutputControllerCompleteBase::IsUpdaterThreadActive() const { return (m_updaterThread && m_updaterThread->joinable()) || m_updaterTaskState != UpdaterTaskState::Inactive; }
 
-void OutputControllerCompleteBase::UpdaterThreadDoIt()
+bool OutputControllerCompleteBase::ConnectUpdater()
 {
-   Log::Write(StringExtensions::Build("Updater thread started for {0} {1}", GetXmlElementName(), GetName()));
-
    try
    {
+      ConnectToController();
+   }
+   catch (const std::exception& e)
+   {
+      Log::Exception(StringExtensions::Build("Could not connect to controller. Thread will quit: {0}", e.what()));
       try
       {
-         ConnectToController();
+         DisconnectFromController();
       }
-      catch (const std::exception& e)
+      catch (...)
       {
-         Log::Exception(StringExtensions::Build("Could not connect to controller. Thread will quit: {0}", e.what()));
-         try
-         {
-            DisconnectFromController();
-         }
-         catch (...)
-         {
-         }
-         m_updaterThreadFinished = true;
-         return;
       }
+      return false;
+   }
 
-      Log::Write(StringExtensions::Build("Updater thread connected to {0} {1}", GetXmlElementName(), GetName()));
+   Log::Write(StringExtensions::Build("Updater thread connected to {0} {1}", GetXmlElementName(), GetName()));
 
-      while (m_keepUpdaterThreadAlive)
+   m_sentGeneration = 0;
+   m_fullUpdateRequired = true;
+   m_commandDeferred = false;
+   m_commandBucket.Reset();
+   return true;
+}
+
+bool OutputControllerCompleteBase::SendOutputValues()
+{
+   uint64_t generation;
+   const std::vector<OutputValueRange>* changedRanges;
+   const std::vector<uint8_t>& valuesToSend = AcquireOutputValues(generation, changedRanges);
+
+   if (generation == m_sentGeneration || (m_commandDeferred && std::chrono::steady_clock::now() < m_commandBucket.GetNextTokenTime()))
+      return true;
+
+   m_commandDeferred = false;
+   try
+   {
+      if (m_inUseState == InUseState::ValueChanged)
       {
-         std::vector<uint8_t> valuesToSend;
-         {
-            std::lock_guard<std::mutex> lock(m_valueChangeMutex);
-            valuesToSend = m_outputValues;
-         }
+         UpdateOutputs(GetZeroValues(valuesToSend.size()), GetFullRange(valuesToSend.size()));
+         if (m_commandDeferred)
+            return true;
 
-         bool updateOK = true;
-         try
-         {
-            if (m_inUseState == InUseState::ValueChanged)
-            {
-               std::vector<uint8_t> zeroValues(valuesToSend.size(), 0);
-               UpdateOutputs(zeroValues);
+         m_inUseState = InUseState::Running;
+         m_fullUpdateRequired = true;
+      }
 
-               m_inUseState = InUseState::Running;
-            }
+      if (m_inUseState == InUseState::Running)
+      {
+         // The changed ranges only cover the difference to the previous generation, so all outputs are sent if a frame was skipped.
+         bool frameSkipped = generation != m_sentGeneration + 1;
+         UpdateOutputs(valuesToSend, (m_fullUpdateRequired || frameSkipped) ? GetFullRange(valuesToSend.size()) : *changedRanges);
+
+         // The rest of a deferred frame is sent together with whatever frame is the latest one once the device accepts commands again.
+         m_fullUpdateRequired = m_commandDeferred;
+         if (m_commandDeferred)
+            return true;
+      }
 
-            if (m_inUseState == InUseState::Running)
-               UpdateOutputs(valuesToSend);
-         }
-         catch (const std::exception& e)
-         {
-            Log::Exception(StringExtensions::Build("Could not send update: {0}. Will try again.", e.what()));
-            updateOK = false;
-         }
+      if (m_sentGeneration != 0 && generation > m_sentGeneration + 1)
+         m_droppedFrameCount += generation - m_sentGeneration - 1;
+      m_sentFrameCount++;
+      int64_t latencyUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_valueBufferTimes[m_frontBuffer]).count();
+      m_totalLatencyUs += latencyUs;
+      if (latencyUs > m_maxLatencyUs)
+         m_maxLatencyUs = latencyUs;
 
-         if (!updateOK)
-         {
-            Log::Warning("Trying to reconnect to controller...");
-            try
-            {
-               DisconnectFromController();
-            }
-            catch (...)
-            {
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            try
-            {
-               ConnectToController();
-            }
-            catch (...)
-            {
-               break;
-            }
-            Log::Write("Reconnected to controller");
-         }
+      m_sentGeneration = generation;
+   }
+   catch (const std::exception& e)
+   {
+      Log::Exception(StringExtensions::Build("Could not send update: {0}. Will try again.", e.what()));
+      m_fullUpdateRequired = true;
+      return false;
+   }
+   return true;
+}
 
-         if (m_keepUpdaterThreadAlive)
-         {
-            std::unique_lock<std::mutex> lock(m_conditionMutex);
-            m_updateCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return !m_keepUpdaterThreadAlive || m_updateRequired; });
-         }
-         m_updateRequired = false;
+void OutputControllerCompleteBase::BeginReconnect()
+{
+   Log::Warning("Trying to reconnect to controller...");
+   try
+   {
+      DisconnectFromController();
+   }
+   catch (...)
+   {
+   }
+}
+
+bool OutputControllerCompleteBase::EndReconnect()
+{
+   try
+   {
+      ConnectToController();
+   }
+   catch (...)
+   {
+      return false;
+   }
+   Log::Write("Reconnected to controller");
+   return true;
+}
+
+void OutputControllerCompleteBase::DisconnectUpdater()
+{
+   m_waitForCommandSlot = true;
+   try
+   {
+      if (m_inUseState != InUseState::Startup)
+      {
+         UpdateOutputs(GetZeroValues(m_outputValues.size()), GetFullRange(m_outputValues.size()));
       }
+   }
+   catch (const std::exception& e)
+   {
+      Log::Exception(StringExtensions::Build("Exception occurred while trying to turn off all outputs: {0}", e.what()));
+   }
 
-      try
+   try
+   {
+      DisconnectFromController();
+   }
+   catch (...)
+   {
+   }
+   m_waitForCommandSlot = false;
+   Log::Write("Updater thread disconnected and will terminate");
+}
+
+std::chrono::steady_clock::time_point OutputControllerCompleteBase::RunOutputUpdate()
+{
+   switch (m_updaterTaskState)
+   {
+   case UpdaterTaskState::Connecting:
+      if (!ConnectUpdater())
       {
-         if (m_inUseState != InUseState::Startup)
-         {
-            std::vector<uint8_t> zeroValues(m_outputValues.size(), 0);
-            UpdateOutputs(zeroValues);
-         }
+         m_updaterTaskState = UpdaterTaskState::Stopped;
+         return std::chrono::steady_clock::time_point::max();
       }
-      catch (const std::exception& e)
+      m_updaterTaskState = UpdaterTaskState::Running;
+      break;
+   case UpdaterTaskState::Reconnecting:
+      if (!EndReconnect())
       {
-         Log::Exception(StringExtensions::Build("Exception occurred while trying to turn off all outputs: {0}", e.what()));
+         DisconnectUpdater();
+         m_updaterTaskState = UpdaterTaskState::Stopped;
+         return std::chrono::steady_clock::time_point::max();
       }
+      m_updaterTaskState = UpdaterTaskState::Running;
+      break;
+   case UpdaterTaskState::Running: break;
+   default: return std::chrono::steady_clock::time_point::max();
+   }
 
-      try
+   if (!SendOutputValues())
+   {
+      BeginReconnect();
+      m_updaterTaskState = UpdaterTaskState::Reconnecting;
+      return std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+   }
+   return GetNextSendTime();
+}
+
+void OutputControllerCompleteBase::UpdaterThreadDoIt()
+{
+   Log::Write(StringExtensions::Build("Updater thread started for {0} {1}", GetXmlElementName(), GetName()));
+
+   try
+   {
+      if (!ConnectUpdater())
       {
-         DisconnectFromController();
+         m_updaterThreadFinished = true;
+         return;
       }
-      catch (...)
+
+      while (m_keepUpdaterThreadAlive)
       {
+         if (!SendOutputValues())
+         {
+            BeginReconnect();
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            if (!EndReconnect())
+               break;
+         }
+
+         if (m_keepUpdaterThreadAlive)
+         {
+            std::unique_lock<std::mutex> lock(m_conditionMutex);
+            m_updateCondition.wait_until(lock, std::min(std::chrono::steady_clock::now() + std::chrono::milliseconds(50), GetNextSendTime()),
+               [this] { return !m_keepUpdaterThreadAlive || (m_middleBuffer.load(std::memory_order_relaxed) & FreshBufferFlag) != 0; });
+         }
       }
-      Log::Write("Updater thread disconnected and will terminate");
+
+      DisconnectUpdater();
    }
    catch (const std::exception& e)
    {
@@ -374,4 +618,4 @@ void OutputControllerCompleteBase::UpdaterThreadDoIt()
    m_updaterThreadFinished = true;
 }
 
-}
+}
\ No newline at end of file
@@ -3,7 +3,10 @@
 #include "DOF/DOF.h"
 #include "OutputControllerBase.h"
 #include "ISupportsSetValues.h"
+#include "IOutputUpdateTask.h"
+#include "../../general/TokenBucket.h"
 #include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <vector>
 #include <thread>
@@ -11,7 +14,7 @@
 namespace DOF
 {
 
-class OutputControllerCompleteBase : public OutputControllerBase, public ISupportsSetValues
+class OutputControllerCompleteBase : public OutputControllerBase, public ISupportsSetValues, public IOutputUpdateTask
 {
 public:
    OutputControllerCompleteBase();
@@ -27,6 +30,18 @@ public:
 
 
    virtual void SetValues(int firstOutput, const uint8_t* values, int valueCount) override;
+   virtual std::chrono::steady_clock::time_point RunOutputUpdate() override;
+
+   struct OutputValueRange
+   {
+      int first;
+      int count;
+   };
+
+   uint64_t GetSentFrameCount() const { return m_sentFrameCount; }
+   uint64_t GetDroppedFrameCount() const { return m_droppedFrameCount; }
+   int64_t GetAverageLatencyUs() const;
+   int64_t GetMaxLatencyUs() const { return m_maxLatencyUs; }
 
 protected:
    void SetupOutputs();
@@ -45,6 +60,7 @@ protected:
    virtual void ConnectToController() = 0;
    virtual void DisconnectFromController() = 0;
    virtual void UpdateOutputs(const std::vector<uint8_t>& outputValues) = 0;
+   virtual void UpdateOutputs(const std::vector<uint8_t>& outputValues, const std::vector<OutputValueRange>& /*changedRanges*/) { UpdateOutputs(outputValues); }
 
 
    void InitUpdaterThread();
@@ -52,10 +68,13 @@ protected:
    void UpdaterThreadSignal();
    bool IsUpdaterThreadActive() const;
 
+   void SetMinCommandInterval(std::chrono::steady_clock::duration interval, int burst = 1);
+   bool TryAcquireCommandSlot();
+
 
    std::vector<uint8_t> m_outputValues;
    mutable std::mutex m_valueChangeMutex;
-   bool m_updateRequired;
+   std::atomic<bool> m_updateRequired;
 
    enum class InUseState
    {
@@ -63,7 +82,7 @@ protected:
       ValueChanged,
       Running
    };
-   InUseState m_inUseState;
+   std::atomic<InUseState> m_inUseState;
 
 private:
    std::unique_ptr<std::thread> m_updaterThread;
@@ -73,6 +92,60 @@ private:
    bool m_keepUpdaterThreadAlive;
    std::atomic<bool> m_updaterThreadFinished { false };
    void UpdaterThreadDoIt();
+
+   enum class UpdaterTaskState
+   {
+      Inactive,
+      Connecting,
+      Running,
+      Reconnecting,
+      Stopped
+   };
+   std::atomic<UpdaterTaskState> m_updaterTaskState;
+   bool m_fullUpdateRequired;
+
+   bool ConnectUpdater();
+   bool SendOutputValues();
+   void BeginReconnect();
+   bool EndReconnect();
+   void DisconnectUpdater();
+   std::chrono::steady_clock::time_point GetNextSendTime() const;
+   void LogUpdateStatistics() const;
+
+   // Controllers with a minimum command interval never sleep in the send path. A command which is not allowed yet defers the frame,
+   // and the latest values are sent as soon as the bucket holds a token again.
+   TokenBucket m_commandBucket;
+   bool m_commandDeferred;
+   bool m_waitForCommandSlot;
+
+   std::atomic<uint64_t> m_sentFrameCount;
+   std::atomic<uint64_t> m_droppedFrameCount;
+   std::atomic<int64_t> m_totalLatencyUs;
+   std::atomic<int64_t> m_maxLatencyUs;
+
+   // Triple buffer for handing output values to the updater thread. The main thread copies m_outputValues into the back buffer
+   // and swaps it with the middle buffer, the updater thread swaps the middle buffer with its front buffer when it holds a newer frame.
+   static const int FreshBufferFlag = 4;
+   static const int BufferIndexMask = 3;
+   static const int MaxChangedRanges = 32;
+   std::vector<uint8_t> m_valueBuffers[3];
+   uint64_t m_valueBufferGenerations[3];
+   std::chrono::steady_clock::time_point m_valueBufferTimes[3];
+   std::vector<OutputValueRange> m_valueBufferRanges[3];
+   std::vector<OutputValueRange> m_changedRanges;
+   std::vector<OutputValueRange> m_fullRange;
+   std::atomic<int> m_middleBuffer;
+   int m_backBuffer;
+   int m_frontBuffer;
+   uint64_t m_generation;
+   uint64_t m_sentGeneration;
+   std::vector<uint8_t> m_zeroValues;
+
+   void AddChangedRange(int first, int count);
+   void PublishOutputValues();
+   const std::vector<uint8_t>& AcquireOutputValues(uint64_t& generation, const std::vector<OutputValueRange>*& changedRanges);
+   const std::vector<OutputValueRange>& GetFullRange(size_t size);
+   const std::vector<uint8_t>& GetZeroValues(size_t size);
 };
 
 }
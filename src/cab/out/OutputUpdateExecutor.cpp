@@ -0,0 +1,182 @@
+#include "OutputUpdateExecutor.h"
+#include "../../Log.h"
+#include "../../general/StringExtensions.h"
+
+#include <algorithm>
+
+namespace DOF
+{
+
+static const int MaxWorkerCount = 16;
+
+OutputUpdateExecutor& OutputUpdateExecutor::GetInstance()
+{
+   static OutputUpdateExecutor instance;
+   return instance;
+}
+
+OutputUpdateExecutor::OutputUpdateExecutor()
+   : m_workerCount(0)
+   , m_workerGeneration(0)
+{
+}
+
+OutputUpdateExecutor::~OutputUpdateExecutor() { StopWorkers(); }
+
+void OutputUpdateExecutor::SetWorkerCount(int value)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if (!m_tasks.empty())
+   {
+      Log::Warning("The number of output update workers cannot be changed while output controllers are registered.");
+      return;
+   }
+   m_workerCount = std::clamp(value, 0, MaxWorkerCount);
+}
+
+void OutputUpdateExecutor::Register(IOutputUpdateTask* task)
+{
+   if (!task)
+      return;
+
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (FindScheduledTask(task))
+         return;
+      m_tasks.push_back({ task, std::chrono::steady_clock::now(), false });
+   }
+   StartWorkers();
+   m_taskCondition.notify_one();
+}
+
+void OutputUpdateExecutor::Unregister(IOutputUpdateTask* task)
+{
+   bool stopWorkers = false;
+   {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taskFinishedCondition.wait(lock,
+         [this, task]
+         {
+            ScheduledTask* scheduledTask = FindScheduledTask(task);
+            return !scheduledTask || !scheduledTask->running;
+         });
+
+      m_tasks.erase(std::remove_if(m_tasks.begin(), m_tasks.end(), [task](const ScheduledTask& t) { return t.task == task; }), m_tasks.end());
+      stopWorkers = m_tasks.empty();
+   }
+   if (stopWorkers)
+      StopWorkers();
+}
+
+void OutputUpdateExecutor::Signal(IOutputUpdateTask* task)
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      ScheduledTask* scheduledTask = FindScheduledTask(task);
+      if (!scheduledTask)
+         return;
+      // Signalled tasks are due immediately, but keep their signal time so they are served in order.
+      scheduledTask->deadline = std::min(scheduledTask->deadline, std::chrono::steady_clock::now());
+   }
+   m_taskCondition.notify_one();
+}
+
+void OutputUpdateExecutor::StartWorkers()
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   if (!m_workers.empty() || m_tasks.empty())
+      return;
+
+   for (int i = 0; i < std::max(1, m_workerCount); i++)
+      m_workers.emplace_back(&OutputUpdateExecutor::WorkerDoIt, this, m_workerGeneration);
+
+   Log::Write(StringExtensions::Build("Output update executor started with {0} worker threads", std::to_string(m_workers.size())));
+}
+
+void OutputUpdateExecutor::StopWorkers()
+{
+   std::vector<std::thread> workers;
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_tasks.empty())
+         return;
+      // Workers started later by a new registration belong to the next generation and are not affected.
+      m_workerGeneration++;
+      workers.swap(m_workers);
+   }
+   m_taskCondition.notify_all();
+
+   for (std::thread& worker : workers)
+   {
+      if (worker.joinable())
+         worker.join();
+   }
+}
+
+OutputUpdateExecutor::ScheduledTask* OutputUpdateExecutor::FindScheduledTask(IOutputUpdateTask* task)
+{
+   for (ScheduledTask& scheduledTask : m_tasks)
+   {
+      if (scheduledTask.task == task)
+         return &scheduledTask;
+   }
+   return nullptr;
+}
+
+void OutputUpdateExecutor::WorkerDoIt(uint64_t workerGeneration)
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while (workerGeneration == m_workerGeneration)
+   {
+      // A task is never run by two workers at the same time, so every device sees its updates in order.
+      auto now = std::chrono::steady_clock::now();
+      auto nextDeadline = std::chrono::steady_clock::time_point::max();
+      ScheduledTask* dueTask = nullptr;
+      for (ScheduledTask& scheduledTask : m_tasks)
+      {
+         if (scheduledTask.running)
+            continue;
+         if (scheduledTask.deadline <= now && (!dueTask || scheduledTask.deadline < dueTask->deadline))
+            dueTask = &scheduledTask;
+         else if (scheduledTask.deadline > now)
+            nextDeadline = std::min(nextDeadline, scheduledTask.deadline);
+      }
+
+      if (!dueTask)
+      {
+         if (nextDeadline == std::chrono::steady_clock::time_point::max())
+            m_taskCondition.wait(lock);
+         else
+            m_taskCondition.wait_until(lock, nextDeadline);
+         continue;
+      }
+
+      IOutputUpdateTask* task = dueTask->task;
+      dueTask->running = true;
+      dueTask->deadline = std::chrono::steady_clock::time_point::max();
+      lock.unlock();
+
+      auto requestedDeadline = std::chrono::steady_clock::time_point::max();
+      try
+      {
+         requestedDeadline = task->RunOutputUpdate();
+      }
+      catch (const std::exception& e)
+      {
+         Log::Exception(StringExtensions::Build("Exception occurred in output update task: {0}", e.what()));
+      }
+
+      lock.lock();
+      ScheduledTask* scheduledTask = FindScheduledTask(task);
+      if (scheduledTask)
+      {
+         scheduledTask->running = false;
+         scheduledTask->deadline = std::min(scheduledTask->deadline, requestedDeadline);
+      }
+      m_taskFinishedCondition.notify_all();
+      if (scheduledTask && scheduledTask->deadline != std::chrono::steady_clock::time_point::max())
+         m_taskCondition.notify_one();
+   }
+}
+
+}
\ No newline at end of file
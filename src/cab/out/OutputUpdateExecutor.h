@@ -0,0 +1,59 @@
+#pragma once
+
+#include "DOF/DOF.h"
+#include "IOutputUpdateTask.h"
+
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DOF
+{
+
+// Runs the updates of controllers based on OutputControllerCompleteBase, DirectStripController, FT245RBitbangController and the PacLed64 units.
+// The pool is off by default, since a run can block on device I/O (ACK reads, reconnects) and hold a worker for that time.
+class OutputUpdateExecutor
+{
+public:
+   static OutputUpdateExecutor& GetInstance();
+
+   ~OutputUpdateExecutor();
+
+   int GetWorkerCount() const { return m_workerCount; }
+   void SetWorkerCount(int value);
+   bool IsThreadPerDevice() const { return m_workerCount == 0; }
+
+   void Register(IOutputUpdateTask* task);
+   void Unregister(IOutputUpdateTask* task);
+   void Signal(IOutputUpdateTask* task);
+
+private:
+   OutputUpdateExecutor();
+   OutputUpdateExecutor(const OutputUpdateExecutor&) = delete;
+   OutputUpdateExecutor& operator=(const OutputUpdateExecutor&) = delete;
+
+   struct ScheduledTask
+   {
+      IOutputUpdateTask* task;
+      std::chrono::steady_clock::time_point deadline;
+      bool running;
+   };
+
+   void StartWorkers();
+   void StopWorkers();
+   void WorkerDoIt(uint64_t workerGeneration);
+   ScheduledTask* FindScheduledTask(IOutputUpdateTask* task);
+
+   int m_workerCount;
+   std::vector<ScheduledTask> m_tasks;
+   std::vector<std::thread> m_workers;
+   std::mutex m_mutex;
+   std::condition_variable m_taskCondition;
+   std::condition_variable m_taskFinishedCondition;
+   uint64_t m_workerGeneration;
+};
+
+}
\ No newline at end of file
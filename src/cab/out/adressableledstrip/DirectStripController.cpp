@@ -1,6 +1,7 @@
 #include "DirectStripController.h"
 #include "LedStripOutput.h"
 #include "../../Cabinet.h"
+#include "../OutputUpdateExecutor.h"
 #include "../../../Log.h"
 #include "../../../general/StringExtensions.h"
 #include "../../../general/MathExtensions.h"
@@ -19,6 +20,7 @@ DirectStripController::DirectStripController()
    , m_updateRequired(true)
    , m_updaterThread(nullptr)
    , m_keepUpdaterThreadAlive(false)
+   , m_updaterTaskState(UpdaterTaskState::Inactive)
    , m_controller(nullptr)
 {
    SetNumberOfLeds(1);
@@ -136,6 +138,14 @@ void DirectStripController::InitUpdaterThread()
 {
    if (!IsUpdaterThreadActive())
    {
+      OutputUpdateExecutor& executor = OutputUpdateExecutor::GetInstance();
+      if (!executor.IsThreadPerDevice())
+      {
+         m_updaterTaskState = UpdaterTaskState::Connecting;
+         executor.Register(this);
+         return;
+      }
+
       m_keepUpdaterThreadAlive = true;
       m_updaterThreadFinished = false;
       try
@@ -152,6 +162,15 @@ void DirectStripController::InitUpdaterThread()
 
 void DirectStripController::FinishUpdaterThread()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Unregister(this);
+      if (m_updaterTaskState == UpdaterTaskState::Running)
+         DisconnectUpdater();
+      m_updaterTaskState = UpdaterTaskState::Inactive;
+      return;
+   }
+
    if (m_updaterThread)
    {
       try
@@ -188,13 +207,19 @@ void DirectStripController::FinishUpdaterThread()
 
 void DirectStripController::UpdaterThreadSignal()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Signal(this);
+      return;
+   }
+
    std::lock_guard<std::mutex> lock(m_conditionMutex);
    m_updateCondition.notify_one();
 }
 
-bool DirectStripController::IsUpdaterThreadActive() const { return m_updaterThread && m_updaterThread->joinable(); }
+bool DirectStripController::IsUpdaterThreadActive() const { return (m_updaterThread && m_updaterThread->joinable()) || m_updaterTaskState != UpdaterTaskState::Inactive; }
 
-void DirectStripController::UpdaterThreadDoIt()
+bool DirectStripController::ConnectUpdater()
 {
    if (!m_controller)
    {
@@ -204,12 +229,29 @@ void DirectStripController::UpdaterThreadDoIt()
          Log::Warning(StringExtensions::Build("WS2811 Strip Controller Nr. {0} is not present. Will not send updates.", std::to_string(m_controllerNumber)));
          delete m_controller;
          m_controller = nullptr;
-         m_updaterThreadFinished = true;
-         return;
+         return false;
       }
    }
 
    std::fill(m_outputLedData.begin(), m_outputLedData.end(), 0);
+   if (m_packData)
+      m_controller->SetAndDisplayPackedData(m_outputLedData);
+   else
+      m_controller->SetAndDisplayData(m_outputLedData);
+   return true;
+}
+
+void DirectStripController::SendLedData()
+{
+   if (!m_updateRequired)
+      return;
+
+   {
+      std::lock_guard<std::mutex> lock(m_updateLocker);
+      m_updateRequired = false;
+      std::memcpy(m_outputLedData.data(), m_ledData.data(), m_ledData.size());
+   }
+
    if (m_controller)
    {
       if (m_packData)
@@ -217,33 +259,10 @@ void DirectStripController::UpdaterThreadDoIt()
       else
          m_controller->SetAndDisplayData(m_outputLedData);
    }
+}
 
-   while (m_keepUpdaterThreadAlive)
-   {
-      if (m_updateRequired)
-      {
-         {
-            std::lock_guard<std::mutex> lock(m_updateLocker);
-            m_updateRequired = false;
-            std::memcpy(m_outputLedData.data(), m_ledData.data(), m_ledData.size());
-         }
-
-         if (m_controller)
-         {
-            if (m_packData)
-               m_controller->SetAndDisplayPackedData(m_outputLedData);
-            else
-               m_controller->SetAndDisplayData(m_outputLedData);
-         }
-      }
-
-      if (m_keepUpdaterThreadAlive)
-      {
-         std::unique_lock<std::mutex> lock(m_conditionMutex);
-         m_updateCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return !m_keepUpdaterThreadAlive || m_updateRequired; });
-      }
-   }
-
+void DirectStripController::DisconnectUpdater()
+{
    std::fill(m_outputLedData.begin(), m_outputLedData.end(), 0);
    if (m_controller)
    {
@@ -256,6 +275,45 @@ void DirectStripController::UpdaterThreadDoIt()
       delete m_controller;
       m_controller = nullptr;
    }
+}
+
+std::chrono::steady_clock::time_point DirectStripController::RunOutputUpdate()
+{
+   if (m_updaterTaskState == UpdaterTaskState::Connecting)
+   {
+      if (!ConnectUpdater())
+      {
+         m_updaterTaskState = UpdaterTaskState::Stopped;
+         return std::chrono::steady_clock::time_point::max();
+      }
+      m_updaterTaskState = UpdaterTaskState::Running;
+   }
+
+   if (m_updaterTaskState == UpdaterTaskState::Running)
+      SendLedData();
+   return std::chrono::steady_clock::time_point::max();
+}
+
+void DirectStripController::UpdaterThreadDoIt()
+{
+   if (!ConnectUpdater())
+   {
+      m_updaterThreadFinished = true;
+      return;
+   }
+
+   while (m_keepUpdaterThreadAlive)
+   {
+      SendLedData();
+
+      if (m_keepUpdaterThreadAlive)
+      {
+         std::unique_lock<std::mutex> lock(m_conditionMutex);
+         m_updateCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return !m_keepUpdaterThreadAlive || m_updateRequired; });
+      }
+   }
+
+   DisconnectUpdater();
    m_updaterThreadFinished = true;
 }
 
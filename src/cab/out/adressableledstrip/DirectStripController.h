@@ -3,6 +3,7 @@
 #include "DOF/DOF.h"
 #include "../OutputControllerBase.h"
 #include "../ISupportsSetValues.h"
+#include "../IOutputUpdateTask.h"
 #include "DirectStripControllerApi.h"
 #include <atomic>
 #include <vector>
@@ -16,7 +17,7 @@ namespace DOF
 
 class DirectStripControllerApi;
 
-class DirectStripController : public OutputControllerBase, public ISupportsSetValues
+class DirectStripController : public OutputControllerBase, public ISupportsSetValues, public IOutputUpdateTask
 {
 public:
    DirectStripController();
@@ -41,6 +42,8 @@ public:
    virtual tinyxml2::XMLElement* ToXml(tinyxml2::XMLDocument& doc) const override;
    virtual bool FromXml(const tinyxml2::XMLElement* element) override;
 
+   virtual std::chrono::steady_clock::time_point RunOutputUpdate() override;
+
 protected:
    virtual void OnOutputValueChanged(IOutput* output) override;
 
@@ -51,6 +54,9 @@ private:
    void UpdaterThreadSignal();
    bool IsUpdaterThreadActive() const;
    void UpdaterThreadDoIt();
+   bool ConnectUpdater();
+   void SendLedData();
+   void DisconnectUpdater();
 
    static const std::vector<int> s_colNrLookup;
 
@@ -71,6 +77,15 @@ private:
    bool m_keepUpdaterThreadAlive;
    std::atomic<bool> m_updaterThreadFinished { false };
 
+   enum class UpdaterTaskState
+   {
+      Inactive,
+      Connecting,
+      Running,
+      Stopped
+   };
+   std::atomic<UpdaterTaskState> m_updaterTaskState;
+
    DirectStripControllerApi* m_controller;
 };
 
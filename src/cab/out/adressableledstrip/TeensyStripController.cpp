@@ -22,6 +22,7 @@ TeensyStripController::TeensyStripController()
    , m_comPortHandshakeStartWaitMs(20)
    , m_comPortHandshakeEndWaitMs(50)
    , m_comPortDtrEnable(false)
+   , m_pipelinedAcks(true)
    , m_comPort(nullptr)
    , m_numberOfLedsPerChannel(-1)
 {
@@ -211,28 +212,33 @@ bool TeensyStripController::VerifySettings()
    return true;
 }
 
-void TeensyStripController::SendLedstripData(const std::vector<uint8_t>& outputValues, int targetPosition)
+void TeensyStripController::SendLedstripData(const uint8_t* data, int length, int targetPosition)
 {
-   int nrOfLeds = static_cast<int>(outputValues.size()) / 3;
+   int nrOfLeds = length / 3;
    std::vector<uint8_t> commandData = { (uint8_t)'R', (uint8_t)(targetPosition >> 8), (uint8_t)(targetPosition & 255), (uint8_t)(nrOfLeds >> 8), (uint8_t)(nrOfLeds & 255) };
 
    enum sp_return result = sp_blocking_write(m_comPort, commandData.data(), 5, m_comPortTimeOutMs);
    if (result < 0)
       throw std::runtime_error(StringExtensions::Build("Failed to write command data: {0}", sp_last_error_message()));
 
-   result = sp_blocking_write(m_comPort, outputValues.data(), outputValues.size(), m_comPortTimeOutMs);
+   result = sp_blocking_write(m_comPort, data, length, m_comPortTimeOutMs);
    if (result < 0)
       throw std::runtime_error(StringExtensions::Build("Failed to write output values: {0}", sp_last_error_message()));
 }
 
 void TeensyStripController::UpdateOutputs(const std::vector<uint8_t>& outputValues)
+{
+   UpdateOutputs(outputValues, std::vector<OutputValueRange> { { 0, static_cast<int>(outputValues.size()) } });
+}
+
+void TeensyStripController::UpdateOutputs(const std::vector<uint8_t>& outputValues, const std::vector<OutputValueRange>& changedRanges)
 {
    if (!m_comPort)
       throw std::runtime_error("Comport is not initialized");
 
-   std::vector<uint8_t> commandData;
-   std::vector<uint8_t> answerData;
-   int bytesRead;
+   int pendingAckChannels[10];
+   int pendingAckCount = 0;
+   int sentChannelCount = 0;
    int sourcePosition = 0;
 
    for (int i = 0; i < 10; i++)
@@ -240,55 +246,63 @@ void TeensyStripController::UpdateOutputs(const std::vector<uint8_t>& outputValu
       int nrOfLedsOnStrip = m_numberOfLedsPerStrip[i];
       if (nrOfLedsOnStrip > 0)
       {
-         int targetPosition = i * m_numberOfLedsPerChannel;
+         int firstOutput = sourcePosition * 3;
+         int lastOutput = firstOutput + nrOfLedsOnStrip * 3;
+         bool channelChanged = std::any_of(changedRanges.begin(), changedRanges.end(),
+            [firstOutput, lastOutput](const OutputValueRange& range) { return range.first < lastOutput && range.first + range.count > firstOutput; });
 
-         std::vector<uint8_t> stripData(outputValues.begin() + sourcePosition * 3, outputValues.begin() + sourcePosition * 3 + nrOfLedsOnStrip * 3);
-         SendLedstripData(stripData, targetPosition);
-
-         bytesRead = -1;
-         answerData.resize(1);
-
-         try
+         if (channelChanged)
          {
-            bytesRead = ReadPortWait(answerData.data(), 0, 1);
-         }
-         catch (const std::exception& e)
-         {
-            throw std::runtime_error(
-               StringExtensions::Build("A exception occurred while waiting for the ACK after sending the data for channel {0} of the {1}.", std::to_string(i + 1), GetXmlElementName()));
-         }
+            SendLedstripData(outputValues.data() + firstOutput, nrOfLedsOnStrip * 3, i * m_numberOfLedsPerChannel);
+            sentChannelCount++;
 
-         if (bytesRead != 1 || answerData[0] != (uint8_t)'A')
-         {
-            throw std::runtime_error(StringExtensions::Build(
-               "Received no answer or a unexpected answer while waiting for the ACK after sending the data for channel {0} of the {1}.", std::to_string(i + 1), GetXmlElementName()));
+            if (m_pipelinedAcks)
+               pendingAckChannels[pendingAckCount++] = i;
+            else
+               ReadAck(i);
          }
          sourcePosition += nrOfLedsOnStrip;
       }
    }
 
-   commandData = { (uint8_t)'O' };
-   enum sp_return result = sp_blocking_write(m_comPort, commandData.data(), 1, m_comPortTimeOutMs);
+   if (sentChannelCount == 0)
+      return;
+
+   uint8_t outputCommand = 'O';
+   enum sp_return result = sp_blocking_write(m_comPort, &outputCommand, 1, m_comPortTimeOutMs);
    if (result < 0)
       throw std::runtime_error(StringExtensions::Build("Failed to write output command: {0}", sp_last_error_message()));
 
-   bytesRead = -1;
-   answerData.resize(1);
+   // The controller handles the commands in the order they were received, so the ACKs of all channels can be collected after the output command has been sent.
+   for (int i = 0; i < pendingAckCount; i++)
+      ReadAck(pendingAckChannels[i]);
+
+   ReadAck(-1);
+}
+
+void TeensyStripController::ReadAck(int channel)
+{
+   uint8_t answer = 0;
+   int bytesRead = -1;
 
    try
    {
-      bytesRead = ReadPortWait(answerData.data(), 0, 1);
+      bytesRead = ReadPortWait(&answer, 0, 1);
    }
    catch (const std::exception& e)
    {
-      throw std::runtime_error(StringExtensions::Build("A exception occurred while waiting for the ACK after sending the output command (O) to the {0}", GetXmlElementName()));
+      throw std::runtime_error(StringExtensions::Build("A exception occurred while waiting for the ACK after sending {0}.", GetAckDescription(channel)));
    }
 
-   if (bytesRead != 1 || answerData[0] != (uint8_t)'A')
-   {
-      throw std::runtime_error(
-         StringExtensions::Build("Received no answer or a unexpected answer while waiting for the ACK after sending the output command (O) to the {0}", GetXmlElementName()));
-   }
+   if (bytesRead != 1 || answer != (uint8_t)'A')
+      throw std::runtime_error(StringExtensions::Build("Received no answer or a unexpected answer while waiting for the ACK after sending {0}.", GetAckDescription(channel)));
+}
+
+std::string TeensyStripController::GetAckDescription(int channel) const
+{
+   if (channel < 0)
+      return StringExtensions::Build("the output command (O) to the {0}", GetXmlElementName());
+   return StringExtensions::Build("the data for channel {0} of the {1}", std::to_string(channel + 1), GetXmlElementName());
 }
 
 void TeensyStripController::SetupController()
@@ -616,6 +630,7 @@ bool TeensyStripController::FromXml(const tinyxml2::XMLElement* element)
    loadElement("ComPortHandshakeStartWaitMs", [this](const char* text) { SetComPortHandshakeStartWaitMs(std::stoi(text)); });
    loadElement("ComPortHandshakeEndWaitMs", [this](const char* text) { SetComPortHandshakeEndWaitMs(std::stoi(text)); });
    loadElement("ComPortDtrEnable", [this](const char* text) { SetComPortDtrEnable(std::string(text) == "true"); });
+   loadElement("PipelinedAcks", [this](const char* text) { SetPipelinedAcks(std::string(text) == "true"); });
 
    loadElement("ComPortParity",
       [this](const char* text)
@@ -758,6 +773,10 @@ tinyxml2::XMLElement* TeensyStripController::ToXml(tinyxml2::XMLDocument& doc) c
    comPortDtrEnableElement->SetText(GetComPortDtrEnable() ? "true" : "false");
    element->InsertEndChild(comPortDtrEnableElement);
 
+   tinyxml2::XMLElement* pipelinedAcksElement = doc.NewElement("PipelinedAcks");
+   pipelinedAcksElement->SetText(GetPipelinedAcks() ? "true" : "false");
+   element->InsertEndChild(pipelinedAcksElement);
+
    return element;
 }
 
@@ -95,6 +95,9 @@ public:
    bool GetComPortDtrEnable() const { return m_comPortDtrEnable; }
    void SetComPortDtrEnable(bool value) { m_comPortDtrEnable = value; }
 
+   bool GetPipelinedAcks() const { return m_pipelinedAcks; }
+   void SetPipelinedAcks(bool value) { m_pipelinedAcks = value; }
+
    virtual std::string GetXmlElementName() const override { return "TeensyStripController"; }
 
    virtual tinyxml2::XMLElement* ToXml(tinyxml2::XMLDocument& doc) const override;
@@ -106,10 +109,13 @@ protected:
    virtual void ConnectToController() override;
    virtual void DisconnectFromController() override;
    virtual void UpdateOutputs(const std::vector<uint8_t>& outputValues) override;
+   virtual void UpdateOutputs(const std::vector<uint8_t>& outputValues, const std::vector<OutputValueRange>& changedRanges) override;
 
-   virtual void SendLedstripData(const std::vector<uint8_t>& outputValues, int targetPosition);
+   virtual void SendLedstripData(const uint8_t* data, int length, int targetPosition);
    virtual void SetupController();
    int ReadPortWait(uint8_t* buffer, int bufferOffset, int numberOfBytes);
+   void ReadAck(int channel);
+   std::string GetAckDescription(int channel) const;
 
    const std::vector<int>& GetNumberOfLedsPerStrip() const { return m_numberOfLedsPerStrip; }
    int GetNumberOfLedsPerChannel() const { return m_numberOfLedsPerChannel; }
@@ -126,6 +132,7 @@ private:
    int m_comPortHandshakeStartWaitMs;
    int m_comPortHandshakeEndWaitMs;
    bool m_comPortDtrEnable;
+   bool m_pipelinedAcks;
 
    struct sp_port* m_comPort;
    int m_numberOfLedsPerChannel;
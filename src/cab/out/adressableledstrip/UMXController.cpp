@@ -8,7 +8,6 @@
 #include "../../../Log.h"
 #include "../../../general/StringExtensions.h"
 #include <algorithm>
-#include <thread>
 
 namespace DOF
 {
@@ -18,7 +17,6 @@ const int UMXController::MinDataLineDelayMs;
 UMXController::UMXController()
    : m_number(-1)
    , m_dev(nullptr)
-   , m_lastTimeInit(false)
    , m_longestDataLineDelayMs(16)
 {
 }
@@ -71,20 +69,11 @@ bool UMXController::VerifySettings()
 
 void UMXController::UpdateOutputs(const std::vector<uint8_t>& outputValues)
 {
-   auto now = std::chrono::steady_clock::now();
-   int delay = m_lastTimeInit ? static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastTime).count()) : 0;
+   if (!TryAcquireCommandSlot())
+      return;
 
-   if (!m_lastTimeInit || delay >= m_longestDataLineDelayMs)
-   {
-      if (m_dev)
-         m_dev->UpdateOutputs(outputValues);
-      m_lastTime = std::chrono::steady_clock::now();
-      m_lastTimeInit = true;
-   }
-   else
-   {
-      std::this_thread::sleep_for(std::chrono::milliseconds(m_longestDataLineDelayMs - delay));
-   }
+   if (m_dev)
+      m_dev->UpdateOutputs(outputValues);
 }
 
 void UMXController::UpdateCabinetFromConfig(Cabinet* cabinet)
@@ -142,9 +131,9 @@ void UMXController::UpdateCabinetFromConfig(Cabinet* cabinet)
 
    m_dev->CreateDataLines();
 
-   Log::Instrumentation("UMX", StringExtensions::Build("{0} Output lines generated", std::to_string(m_dev->m_dataLines.size())));
+   DOF_INSTRUMENTATION("UMX", StringExtensions::Build("{0} Output lines generated", std::to_string(m_dev->m_dataLines.size())));
    for (const auto& line : m_dev->m_dataLines)
-      Log::Instrumentation("UMX", StringExtensions::Build("\t{0} leds", std::to_string(line.m_nbLeds)));
+      DOF_INSTRUMENTATION("UMX", StringExtensions::Build("\t{0} leds", std::to_string(line.m_nbLeds)));
 
    int ledsRefresh = 30000;
    for (const auto& cap : UMXDevice::LedsCaps)
@@ -161,8 +150,9 @@ void UMXController::UpdateCabinetFromConfig(Cabinet* cabinet)
    else
       m_longestDataLineDelayMs = 16;
    m_longestDataLineDelayMs = std::max(m_longestDataLineDelayMs, MinDataLineDelayMs);
+   SetMinCommandInterval(std::chrono::milliseconds(m_longestDataLineDelayMs));
 
-   Log::Instrumentation("UMX",
+   DOF_INSTRUMENTATION("UMX",
       StringExtensions::Build(
          "\tLongest Dataline is {0} leds (controller delay is set at {1} ms)", std::to_string(m_dev->m_longestDataLineNbLeds), std::to_string(m_longestDataLineDelayMs)));
 
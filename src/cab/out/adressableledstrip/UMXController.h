@@ -38,8 +38,6 @@ private:
    int m_number;
    UMXDevice* m_dev;
 
-   std::chrono::steady_clock::time_point m_lastTime;
-   bool m_lastTimeInit;
    static const int MinDataLineDelayMs = 5;
    int m_longestDataLineDelayMs;
 };
@@ -29,7 +29,7 @@ void UMXControllerAutoConfigurator::AddUMXDevice(UMXDevice* dev)
       {
          UMXController* umxC = new UMXController();
          umxC->SetNumber(dev->UnitNo());
-         Log::Instrumentation(
+         DOF_INSTRUMENTATION(
             "UMX", StringExtensions::Build("Adding new device {0} & controller {1} to cabinet after UMXControllerAutoConfigurator initialization", dev->m_name, umxC->GetName()));
          umxC->UpdateCabinetFromConfig(s_cabinet);
       }
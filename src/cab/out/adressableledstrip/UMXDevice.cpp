@@ -125,7 +125,7 @@ void UMXDevice::UpdateOutputs(const std::vector<uint8_t>& outputValues)
 
             if (compRatio < m_compressionRatio * 0.01f)
             {
-               Log::Instrumentation("UMX", StringExtensions::Build("Send compressed Mx Data (ratio {0}%)", std::to_string(static_cast<int>(compRatio * 100))));
+               DOF_INSTRUMENTATION("UMX", StringExtensions::Build("Send compressed Mx Data (ratio {0}%)", std::to_string(static_cast<int>(compRatio * 100))));
                sendBuffer.push_back(1);
                sendBuffer.push_back(static_cast<uint8_t>(compressedLine.size() & 0xFF));
                sendBuffer.push_back(static_cast<uint8_t>(compressedLine.size() >> 8));
@@ -13,6 +13,7 @@ WemosD1MPStripController::WemosD1MPStripController()
    , m_useCompression(false)
    , m_testOnConnect(false)
 {
+   SetPipelinedAcks(false);
 }
 
 void WemosD1MPStripController::SetupController()
@@ -98,66 +99,54 @@ void WemosD1MPStripController::SetupController()
    }
 }
 
-void WemosD1MPStripController::SendLedstripData(const std::vector<uint8_t>& outputValues, int targetPosition)
+void WemosD1MPStripController::SendLedstripData(const uint8_t* data, int length, int targetPosition)
 {
    if (m_useCompression)
    {
       m_compressedData.clear();
-      m_uncompressedData.clear();
-      m_uncompressedData.assign(outputValues.begin(), outputValues.end());
 
-      while (!m_uncompressedData.empty())
+      int position = 0;
+      while (position + 2 < length)
       {
-         if (m_uncompressedData.size() == 3)
-         {
-            m_compressedData.push_back(1);
-            m_compressedData.push_back(m_uncompressedData[0]);
-            m_compressedData.push_back(m_uncompressedData[1]);
-            m_compressedData.push_back(m_uncompressedData[2]);
-            m_uncompressedData.erase(m_uncompressedData.begin(), m_uncompressedData.begin() + 3);
-         }
-         else
-         {
-            uint8_t r = m_uncompressedData[0];
-            uint8_t g = m_uncompressedData[1];
-            uint8_t b = m_uncompressedData[2];
-            m_uncompressedData.erase(m_uncompressedData.begin(), m_uncompressedData.begin() + 3);
-
-            int value = (r << 16) | (g << 8) | b;
-            int cnt = 1;
+         uint8_t r = data[position];
+         uint8_t g = data[position + 1];
+         uint8_t b = data[position + 2];
+         position += 3;
 
-            while (!m_uncompressedData.empty() && ((m_uncompressedData[0] << 16) | (m_uncompressedData[1] << 8) | m_uncompressedData[2]) == value && cnt < UCHAR_MAX - 1)
-            {
-               m_uncompressedData.erase(m_uncompressedData.begin(), m_uncompressedData.begin() + 3);
-               cnt++;
-            }
+         int value = (r << 16) | (g << 8) | b;
+         int cnt = 1;
 
-            m_compressedData.push_back((uint8_t)cnt);
-            m_compressedData.push_back(r);
-            m_compressedData.push_back(g);
-            m_compressedData.push_back(b);
+         while (position + 2 < length && ((data[position] << 16) | (data[position + 1] << 8) | data[position + 2]) == value && cnt < UCHAR_MAX - 1)
+         {
+            position += 3;
+            cnt++;
          }
+
+         m_compressedData.push_back((uint8_t)cnt);
+         m_compressedData.push_back(r);
+         m_compressedData.push_back(g);
+         m_compressedData.push_back(b);
       }
 
-      if (m_compressedData.size() < outputValues.size())
+      if (static_cast<int>(m_compressedData.size()) < length)
       {
          int nbData = static_cast<int>(m_compressedData.size()) / 4;
-         int nbLeds = static_cast<int>(outputValues.size()) / 3;
+         int nbLeds = length / 3;
 
-         std::vector<uint8_t> commandData = { (uint8_t)'Q', (uint8_t)(targetPosition >> 8), (uint8_t)(targetPosition & 255), (uint8_t)(nbData >> 8), (uint8_t)(nbData & 255),
-            (uint8_t)(nbLeds >> 8), (uint8_t)(nbLeds & 255) };
+         uint8_t commandData[7] = { (uint8_t)'Q', (uint8_t)(targetPosition >> 8), (uint8_t)(targetPosition & 255), (uint8_t)(nbData >> 8), (uint8_t)(nbData & 255), (uint8_t)(nbLeds >> 8),
+            (uint8_t)(nbLeds & 255) };
 
-         sp_blocking_write(GetComPort(), commandData.data(), 7, GetComPortTimeOutMs());
+         sp_blocking_write(GetComPort(), commandData, 7, GetComPortTimeOutMs());
          sp_blocking_write(GetComPort(), m_compressedData.data(), m_compressedData.size(), GetComPortTimeOutMs());
       }
       else
       {
-         TeensyStripController::SendLedstripData(outputValues, targetPosition);
+         TeensyStripController::SendLedstripData(data, length, targetPosition);
       }
    }
    else
    {
-      TeensyStripController::SendLedstripData(outputValues, targetPosition);
+      TeensyStripController::SendLedstripData(data, length, targetPosition);
    }
 }
 
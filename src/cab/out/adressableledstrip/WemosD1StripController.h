@@ -29,11 +29,10 @@ public:
 
 protected:
    virtual void SetupController() override;
-   virtual void SendLedstripData(const std::vector<uint8_t>& outputValues, int targetPosition) override;
+   virtual void SendLedstripData(const uint8_t* data, int length, int targetPosition) override;
 
 protected:
    std::vector<uint8_t> m_compressedData;
-   std::vector<uint8_t> m_uncompressedData;
 
 private:
    bool m_sendPerLedstripLength;
@@ -7,7 +7,6 @@
 #include "UMXDudesCabDevice.h"
 #include <algorithm>
 #include <cstring>
-#include <thread>
 #include <sstream>
 
 #include <hidapi/hidapi.h>
@@ -32,7 +31,6 @@ DudesCab::DudesCab()
    , m_minCommandIntervalMs(1)
    , m_minCommandIntervalMsSet(false)
    , m_dev(nullptr)
-   , m_lastUpdate(std::chrono::steady_clock::now())
 {
 }
 
@@ -81,6 +79,7 @@ void DudesCab::Init(Cabinet* cabinet)
       && cabinet->GetOwner()->GetConfigurationSettings().find("DudesCabDefaultMinCommandIntervalMs") != cabinet->GetOwner()->GetConfigurationSettings().end())
       m_minCommandIntervalMs = 1;
 
+   SetMinCommandInterval(std::chrono::milliseconds(m_minCommandIntervalMs));
    OutputControllerFlexCompleteBase::Init(cabinet);
 }
 
@@ -93,8 +92,6 @@ void DudesCab::Finish()
 
 bool DudesCab::VerifySettings() { return true; }
 
-void DudesCab::Instrumentation(const std::string& message) { Log::Instrumentation("DudesCab", message); }
-
 void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
 {
    if (m_dev == nullptr)
@@ -102,6 +99,9 @@ void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
 
    if (newOutputValues != m_oldOutputValues)
    {
+      if (!TryAcquireCommandSlot())
+         return;
+
       m_outputBuffer.clear();
       m_outputBuffer.push_back(0);
       int nbValuesToSend = 0;
@@ -120,7 +120,7 @@ void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
 
             if (m_dev->HasOutputEnabled(extNum, outputNum))
             {
-               Instrumentation(StringExtensions::Build("Prepare Dof Value to send : DOF #{0} {1} => {2}, Extension #{3}, Output #{4}",
+               DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("Prepare Dof Value to send : DOF #{0} {1} => {2}, Extension #{3}, Output #{4}",
                   { std::to_string(numDofOutput), m_oldOutputValues.size() > static_cast<size_t>(numDofOutput) ? std::to_string(m_oldOutputValues[numDofOutput]) : "0",
                      std::to_string(newOutputValues[numDofOutput]), std::to_string(extNum), std::to_string(outputNum) }));
 
@@ -132,10 +132,10 @@ void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
                   {
                      m_outputBuffer[outputMaskOffset] = static_cast<uint8_t>(outputMask & 0xFF);
                      m_outputBuffer[outputMaskOffset + 1] = static_cast<uint8_t>((outputMask >> 8) & 0xFF);
-                     Instrumentation(StringExtensions::Build("        Changed OutputMask 0x{0:X4}", std::to_string(outputMask)));
+                     DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("        Changed OutputMask 0x{0:X4}", std::to_string(outputMask)));
                      outputMask = 0;
                   }
-                  Instrumentation(StringExtensions::Build("    Extension {0} has changes", std::to_string(extNum)));
+                  DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("    Extension {0} has changes", std::to_string(extNum)));
                   outputMaskOffset = static_cast<int>(m_outputBuffer.size());
                   m_outputBuffer.push_back(0);
                   m_outputBuffer.push_back(0);
@@ -147,7 +147,7 @@ void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
             }
             else
             {
-               Instrumentation(StringExtensions::Build("You are sending Pwm updates to a disabled output or a missing extension (ext: {0}, output: {1}), it could be a wrong configuration "
+               DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("You are sending Pwm updates to a disabled output or a missing extension (ext: {0}, output: {1}), it could be a wrong configuration "
                                                        "or a missmatch with your config on dofconfigtool site.",
                   std::to_string(extNum + 1), std::to_string(outputNum + 1)));
             }
@@ -158,12 +158,12 @@ void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
       {
          m_outputBuffer[outputMaskOffset] = static_cast<uint8_t>(outputMask & 0xFF);
          m_outputBuffer[outputMaskOffset + 1] = static_cast<uint8_t>((outputMask >> 8) & 0xFF);
-         Instrumentation(StringExtensions::Build("        Changed OutputMask 0x{0:X4}", std::to_string(outputMask)));
+         DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("        Changed OutputMask 0x{0:X4}", std::to_string(outputMask)));
       }
       m_outputBuffer[0] = extMask;
-      Instrumentation(StringExtensions::Build("    ExtenstionMask 0x{0:X2}", std::to_string(m_outputBuffer[0])));
+      DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("    ExtenstionMask 0x{0:X2}", std::to_string(m_outputBuffer[0])));
 
-      Instrumentation(StringExtensions::Build("{0} Dof Values to send to Dude's cab", std::to_string(nbValuesToSend)));
+      DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("{0} Dof Values to send to Dude's cab", std::to_string(nbValuesToSend)));
 
       m_dev->SendCommand(Device::HIDReportType::RT_PWM_OUTPUTS, m_outputBuffer);
 
@@ -171,16 +171,6 @@ void DudesCab::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
    }
 }
 
-void DudesCab::UpdateDelay()
-{
-   auto now = std::chrono::steady_clock::now();
-   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastUpdate).count();
-
-   if (elapsed < m_minCommandIntervalMs)
-      std::this_thread::sleep_for(std::chrono::milliseconds(m_minCommandIntervalMs - elapsed));
-   m_lastUpdate = std::chrono::steady_clock::now();
-}
-
 void DudesCab::ConnectToController() { DisconnectFromController(); }
 
 void DudesCab::DisconnectFromController()
@@ -554,9 +544,9 @@ void DudesCab::Device::SendCommand(RIDType rid, uint8_t command, const std::vect
       return;
 
    if (rid == RIDType::RIDOutputs)
-      Log::Instrumentation("DudesCab", StringExtensions::Build("DudesCab SendCommand: {0}", std::to_string(static_cast<int>(command))));
+      DOF_INSTRUMENTATION("DudesCab", StringExtensions::Build("DudesCab SendCommand: {0}", std::to_string(static_cast<int>(command))));
    else
-      Log::Instrumentation("DudesCab,Mx", StringExtensions::Build("DudesCab SendCommand: {0}", std::to_string(static_cast<int>(command))));
+      DOF_INSTRUMENTATION("DudesCab,Mx", StringExtensions::Build("DudesCab SendCommand: {0}", std::to_string(static_cast<int>(command))));
 
    std::vector<uint8_t> data = parameters;
 
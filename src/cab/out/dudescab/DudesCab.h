@@ -200,9 +200,6 @@ private:
    std::vector<uint8_t> m_oldOutputValues;
    std::vector<uint8_t> m_outputBuffer;
 
-   std::chrono::steady_clock::time_point m_lastUpdate;
-   void UpdateDelay();
-   void Instrumentation(const std::string& message);
 
    static std::vector<Device*> FindDevices();
    static std::vector<Device*> s_devices;
@@ -6,6 +6,7 @@
 #include "../../overrides/TableOverrideSettings.h"
 #include "../../schedules/ScheduledSettings.h"
 #include "../Output.h"
+#include "../OutputUpdateExecutor.h"
 #include "../OutputList.h"
 #include <stdexcept>
 #include <chrono>
@@ -21,6 +22,7 @@ FT245RBitbangController::FT245RBitbangController()
    , m_keepUpdaterThreadAlive(false)
    , m_updaterThreadFinished(false)
    , m_firstTryFailCnt(0)
+   , m_updaterTaskState(UpdaterTaskState::Inactive)
    , m_updaterThread(nullptr)
    , m_ftdi(nullptr)
 {
@@ -119,12 +121,24 @@ void FT245RBitbangController::OnOutputValueChanged(IOutput* output)
    }
 }
 
-bool FT245RBitbangController::GetUpdaterThreadIsActive() const { return m_updaterThread && m_updaterThread->joinable() && m_keepUpdaterThreadAlive; }
+bool FT245RBitbangController::GetUpdaterThreadIsActive() const
+{
+   return (m_updaterThread && m_updaterThread->joinable() && m_keepUpdaterThreadAlive) || m_updaterTaskState == UpdaterTaskState::Connecting
+      || m_updaterTaskState == UpdaterTaskState::Running;
+}
 
 void FT245RBitbangController::InitUpdaterThread()
 {
    if (!GetUpdaterThreadIsActive())
    {
+      OutputUpdateExecutor& executor = OutputUpdateExecutor::GetInstance();
+      if (!executor.IsThreadPerDevice())
+      {
+         m_updaterTaskState = UpdaterTaskState::Connecting;
+         executor.Register(this);
+         return;
+      }
+
       m_keepUpdaterThreadAlive = true;
       m_updaterThreadFinished = false;
       try
@@ -141,6 +155,15 @@ void FT245RBitbangController::InitUpdaterThread()
 
 void FT245RBitbangController::FinishUpdaterThread()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Unregister(this);
+      if (m_updaterTaskState == UpdaterTaskState::Running)
+         DisconnectUpdater();
+      m_updaterTaskState = UpdaterTaskState::Inactive;
+      return;
+   }
+
    if (m_updaterThread)
    {
       try
@@ -174,18 +197,23 @@ void FT245RBitbangController::FinishUpdaterThread()
 
 void FT245RBitbangController::UpdaterThreadSignal()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Signal(this);
+      return;
+   }
+
    std::lock_guard<std::mutex> lock(m_updaterThreadLocker);
    m_updaterThreadCondition.notify_one();
 }
 
-void FT245RBitbangController::UpdaterThreadDoIt()
+bool FT245RBitbangController::ConnectUpdater()
 {
    Connect();
    if (!m_ftdi)
    {
       Log::Warning(StringExtensions::Build("No connection to FTDI chip {0}. Updater thread will terminate.", m_serialNumber));
-      m_updaterThreadFinished = true;
-      return;
+      return false;
    }
 
    try
@@ -196,68 +224,66 @@ void FT245RBitbangController::UpdaterThreadDoIt()
    {
       Log::Exception(StringExtensions::Build("Could not send initial update to FTDI chip {0}. Updater thread will terminate.", m_serialNumber));
       Disconnect();
-      m_updaterThreadFinished = true;
-      return;
+      return false;
    }
+   return true;
+}
 
-   while (m_keepUpdaterThreadAlive)
+bool FT245RBitbangController::SendOutputValue()
+{
+   m_currentValue = m_newValue.load();
+
+   try
+   {
+      SendUpdate(m_currentValue);
+   }
+   catch (const std::exception& e)
    {
-      m_currentValue = m_newValue.load();
+      if (m_firstTryFailCnt < 5)
+      {
+         Log::Exception(StringExtensions::Build("Could not send update to FTDI chip {0} on first try. Will reconnect and send update again.", m_serialNumber));
+         m_firstTryFailCnt++;
+         if (m_firstTryFailCnt == 5)
+         {
+            Log::Warning(StringExtensions::Build("Will not log further warnings on first try failures when sending data to FTDI chip {0}.", m_serialNumber));
+         }
+      }
 
       try
       {
-         SendUpdate(m_currentValue);
+         Disconnect();
+         Connect();
       }
-      catch (const std::exception& e)
+      catch (const std::exception& ec)
       {
-         if (m_firstTryFailCnt < 5)
-         {
-            Log::Exception(StringExtensions::Build("Could not send update to FTDI chip {0} on first try. Will reconnect and send update again.", m_serialNumber));
-            m_firstTryFailCnt++;
-            if (m_firstTryFailCnt == 5)
-            {
-               Log::Warning(StringExtensions::Build("Will not log further warnings on first try failures when sending data to FTDI chip {0}.", m_serialNumber));
-            }
-         }
+         Log::Exception(StringExtensions::Build("Could not send update to FTDI chip {0}. Tried to reconnect to device but failed. Updater thread will terminate.", m_serialNumber));
+         return false;
+      }
 
+      if (m_ftdi)
+      {
          try
          {
-            Disconnect();
-            Connect();
+            SendUpdate(m_currentValue);
          }
-         catch (const std::exception& ec)
+         catch (const std::exception& ee)
          {
-            Log::Exception(StringExtensions::Build("Could not send update to FTDI chip {0}. Tried to reconnect to device but failed. Updater thread will terminate.", m_serialNumber));
-            break;
-         }
-
-         if (m_ftdi)
-         {
-            try
-            {
-               SendUpdate(m_currentValue);
-            }
-            catch (const std::exception& ee)
-            {
-               Log::Exception(StringExtensions::Build(
-                  "Could not send update to FTDI chip {0}. Reconnect to device worked, but sending the update did fail again. Updater thread will terminate.", m_serialNumber));
-               break;
-            }
-         }
-         else
-         {
-            Log::Exception(StringExtensions::Build("Could not send update to FTDI chip {0}. Tried to reconnect to device but failed. Updater thread will terminate.", m_serialNumber));
-            break;
+            Log::Exception(StringExtensions::Build(
+               "Could not send update to FTDI chip {0}. Reconnect to device worked, but sending the update did fail again. Updater thread will terminate.", m_serialNumber));
+            return false;
          }
       }
-
-      if (m_keepUpdaterThreadAlive)
+      else
       {
-         std::unique_lock<std::mutex> lock(m_updaterThreadLocker);
-         m_updaterThreadCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() { return m_newValue != m_currentValue || !m_keepUpdaterThreadAlive; });
+         Log::Exception(StringExtensions::Build("Could not send update to FTDI chip {0}. Tried to reconnect to device but failed. Updater thread will terminate.", m_serialNumber));
+         return false;
       }
    }
+   return true;
+}
 
+void FT245RBitbangController::DisconnectUpdater()
+{
    try
    {
       SendUpdate(0);
@@ -267,6 +293,50 @@ void FT245RBitbangController::UpdaterThreadDoIt()
       Log::Exception(StringExtensions::Build("Final update to turn off all output for FTDI chip {0} failed.", m_serialNumber));
    }
    Disconnect();
+}
+
+std::chrono::steady_clock::time_point FT245RBitbangController::RunOutputUpdate()
+{
+   if (m_updaterTaskState == UpdaterTaskState::Connecting)
+   {
+      if (!ConnectUpdater())
+      {
+         m_updaterTaskState = UpdaterTaskState::Stopped;
+         return std::chrono::steady_clock::time_point::max();
+      }
+      m_updaterTaskState = UpdaterTaskState::Running;
+   }
+
+   // Without a dedicated thread the output byte is only written when it changes, instead of every 50ms.
+   if (m_updaterTaskState == UpdaterTaskState::Running && m_newValue != m_currentValue && !SendOutputValue())
+   {
+      DisconnectUpdater();
+      m_updaterTaskState = UpdaterTaskState::Stopped;
+   }
+   return std::chrono::steady_clock::time_point::max();
+}
+
+void FT245RBitbangController::UpdaterThreadDoIt()
+{
+   if (!ConnectUpdater())
+   {
+      m_updaterThreadFinished = true;
+      return;
+   }
+
+   while (m_keepUpdaterThreadAlive)
+   {
+      if (!SendOutputValue())
+         break;
+
+      if (m_keepUpdaterThreadAlive)
+      {
+         std::unique_lock<std::mutex> lock(m_updaterThreadLocker);
+         m_updaterThreadCondition.wait_for(lock, std::chrono::milliseconds(50), [this]() { return m_newValue != m_currentValue || !m_keepUpdaterThreadAlive; });
+      }
+   }
+
+   DisconnectUpdater();
    m_updaterThreadFinished = true;
 }
 
@@ -2,6 +2,7 @@
 
 #include "../OutputControllerBase.h"
 #include "../IOutputController.h"
+#include "../IOutputUpdateTask.h"
 #include "FTDI.h"
 #include <string>
 #include <thread>
@@ -14,7 +15,7 @@ namespace DOF
 
 class Cabinet;
 
-class FT245RBitbangController : public OutputControllerBase
+class FT245RBitbangController : public OutputControllerBase, public IOutputUpdateTask
 {
 public:
    FT245RBitbangController();
@@ -39,6 +40,8 @@ public:
    virtual tinyxml2::XMLElement* ToXml(tinyxml2::XMLDocument& doc) const override;
    virtual bool FromXml(const tinyxml2::XMLElement* element) override;
 
+   virtual std::chrono::steady_clock::time_point RunOutputUpdate() override;
+
 protected:
    virtual void OnOutputValueChanged(IOutput* output) override;
 
@@ -53,6 +56,9 @@ private:
    void FinishUpdaterThread();
    void UpdaterThreadSignal();
    void UpdaterThreadDoIt();
+   bool ConnectUpdater();
+   bool SendOutputValue();
+   void DisconnectUpdater();
 
    std::mutex m_valueChangeLocker;
    std::atomic<uint8_t> m_newValue;
@@ -65,6 +71,15 @@ private:
    std::atomic<bool> m_updaterThreadFinished;
    int m_firstTryFailCnt;
 
+   enum class UpdaterTaskState
+   {
+      Inactive,
+      Connecting,
+      Running,
+      Stopped
+   };
+   std::atomic<UpdaterTaskState> m_updaterTaskState;
+
    std::recursive_mutex m_ftdiLocker;
    FTDI* m_ftdi;
 
@@ -3,6 +3,7 @@
 #include "../../../Log.h"
 #include "../../../general/StringExtensions.h"
 #include "../../Cabinet.h"
+#include "../../../pinballsupport/AlarmHandler.h"
 #include "../Output.h"
 
 #include <algorithm>
@@ -33,6 +34,8 @@ LedWiz::LedWiz()
    m_number = -1;
    m_minCommandIntervalMs = 10;
    m_minCommandIntervalMsSet = false;
+   m_updatePending = false;
+   m_alarmHandler = nullptr;
 }
 
 LedWiz::LedWiz(int number)
@@ -93,6 +96,9 @@ void LedWiz::Init(Cabinet* cabinet)
       }
    }
 
+   m_commandBucket.Configure(std::chrono::milliseconds(m_minCommandIntervalMs));
+   if (cabinet && cabinet->GetOwner())
+      m_alarmHandler = cabinet->GetAlarms();
    ConnectToController();
    Log::Write(StringExtensions::Build("LedWiz Nr. {0:00} initialized and updater thread initialized.", std::to_string(m_number)));
 }
@@ -100,6 +106,11 @@ void LedWiz::Init(Cabinet* cabinet)
 void LedWiz::Finish()
 {
    Log::Write(StringExtensions::Build("Finishing LedWiz Nr. {0:00}", std::to_string(m_number)));
+   if (m_alarmHandler != nullptr)
+   {
+      m_alarmHandler->UnregisterAlarm(Action(this, &LedWiz::SendPendingOutputs));
+      m_alarmHandler = nullptr;
+   }
    if (m_fp)
    {
       AllOff();
@@ -108,7 +119,11 @@ void LedWiz::Finish()
    Log::Write(StringExtensions::Build("LedWiz Nr. {0:00} finished and updater thread stopped.", std::to_string(m_number)));
 }
 
-void LedWiz::Update() { }
+void LedWiz::Update()
+{
+   if (m_updatePending)
+      SendPendingOutputs();
+}
 
 void LedWiz::OnOutputValueChanged(IOutput* output)
 {
@@ -180,9 +195,15 @@ void LedWiz::AllOff()
 {
    if (m_fp)
    {
+      // There is no later update to carry the off command, so wait for a command slot instead of deferring it. The device also gets its
+      // command interval before it is closed.
+      std::this_thread::sleep_until(m_commandBucket.GetNextTokenTime());
+      m_commandBucket.TryConsume(std::chrono::steady_clock::now());
       std::vector<uint8_t> buf = { 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00 };
       WriteUSB(buf);
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      m_updatePending = false;
+      std::fill(m_oldOutputValues.begin(), m_oldOutputValues.end(), 0);
+      std::this_thread::sleep_until(m_commandBucket.GetNextTokenTime());
    }
 }
 
@@ -245,6 +266,20 @@ void LedWiz::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
    if (!m_fp)
       return;
 
+   m_pendingOutputValues = newOutputValues;
+   m_updatePending = true;
+   SendPendingOutputs();
+}
+
+void LedWiz::SendPendingOutputs()
+{
+   const std::vector<uint8_t>& newOutputValues = m_pendingOutputValues;
+   if (!m_fp)
+   {
+      m_updatePending = false;
+      return;
+   }
+
    if (newOutputValues.size() != m_oldOutputValues.size())
    {
       m_oldOutputValues.resize(newOutputValues.size(), 0);
@@ -260,41 +295,58 @@ void LedWiz::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
       }
    }
 
-   if (hasChanges)
+   if (!hasChanges)
    {
-      std::vector<uint8_t> sbaCmd = { 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00 };
+      m_updatePending = false;
+      return;
+   }
 
-      for (int i = 0; i < 32 && i < static_cast<int>(newOutputValues.size()); ++i)
+   // Without a free command slot the values stay pending. An alarm sends the latest ones once the command interval has passed,
+   // as the table may not produce another update.
+   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+   if (!m_commandBucket.TryConsume(now))
+   {
+      if (m_alarmHandler != nullptr)
       {
-         int byteIndex = 2 + (i / 8);
-         int bitIndex = i % 8;
-
-         if (newOutputValues[i] > 127)
-         {
-            sbaCmd[byteIndex] |= (1 << bitIndex);
-         }
+         int retryMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(m_commandBucket.GetNextTokenTime() - now).count()) + 1;
+         m_alarmHandler->RegisterAlarm(retryMs, Action(this, &LedWiz::SendPendingOutputs));
       }
+      return;
+   }
+   m_updatePending = false;
 
-      WriteUSB(sbaCmd);
+   std::vector<uint8_t> sbaCmd = { 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00 };
 
-      for (int ofs = 0; ofs < 32; ofs += 8)
+   for (int i = 0; i < 32 && i < static_cast<int>(newOutputValues.size()); ++i)
+   {
+      int byteIndex = 2 + (i / 8);
+      int bitIndex = i % 8;
+
+      if (newOutputValues[i] > 127)
       {
-         std::vector<uint8_t> pbaCmd = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+         sbaCmd[byteIndex] |= (1 << bitIndex);
+      }
+   }
 
-         for (int i = 0; i < 8; ++i)
+   WriteUSB(sbaCmd);
+
+   for (int ofs = 0; ofs < 32; ofs += 8)
+   {
+      std::vector<uint8_t> pbaCmd = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+      for (int i = 0; i < 8; ++i)
+      {
+         int outputIndex = ofs + i;
+         if (outputIndex < static_cast<int>(newOutputValues.size()))
          {
-            int outputIndex = ofs + i;
-            if (outputIndex < static_cast<int>(newOutputValues.size()))
-            {
-               pbaCmd[1 + i] = static_cast<uint8_t>((newOutputValues[outputIndex] * 49) / 255);
-            }
+            pbaCmd[1 + i] = static_cast<uint8_t>((newOutputValues[outputIndex] * 49) / 255);
          }
-
-         WriteUSB(pbaCmd);
       }
 
-      m_oldOutputValues = newOutputValues;
+      WriteUSB(pbaCmd);
    }
+
+   m_oldOutputValues = newOutputValues;
 }
 
 bool LedWiz::WriteUSB(const std::vector<uint8_t>& data)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../OutputControllerBase.h"
+#include "../../../general/TokenBucket.h"
 #include <hidapi/hidapi.h>
 #include <string>
 #include <chrono>
@@ -9,6 +10,8 @@
 namespace DOF
 {
 
+class AlarmHandler;
+
 class LedWiz : public OutputControllerBase
 {
 public:
@@ -46,6 +49,7 @@ private:
    void ConnectToController();
    void DisconnectFromController();
    void UpdateOutputs(const std::vector<uint8_t>& outputValues);
+   void SendPendingOutputs();
 
 private:
    struct LWDEVICE
@@ -70,6 +74,10 @@ private:
    int m_minCommandIntervalMs;
    bool m_minCommandIntervalMsSet;
    std::vector<uint8_t> m_oldOutputValues;
+   std::vector<uint8_t> m_pendingOutputValues;
+   bool m_updatePending;
+   TokenBucket m_commandBucket;
+   AlarmHandler* m_alarmHandler;
    std::chrono::steady_clock::time_point m_lastUpdate;
    static std::vector<LWDEVICE> s_deviceList;
    hid_device* m_fp;
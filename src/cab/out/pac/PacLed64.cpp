@@ -4,6 +4,7 @@
 #include "../../../general/StringExtensions.h"
 #include "../../Cabinet.h"
 #include "../Output.h"
+#include "../OutputUpdateExecutor.h"
 #include "../../../cab/CabinetOwner.h"
 
 #include <algorithm>
@@ -201,7 +202,7 @@ bool PacLed64::FromXml(const tinyxml2::XMLElement* element)
 PacLed64::PacLed64Unit::PacLed64Unit(int id)
    : m_id(id)
    , m_fullUpdateThreshold(30)
-   , m_minUpdateInterval(std::chrono::milliseconds(10))
+   , m_commandDeferred(false)
    , m_index(-1)
    , m_newValue(64, 0)
    , m_currentValue(64, 0)
@@ -210,9 +211,12 @@ PacLed64::PacLed64Unit::PacLed64Unit(int id)
    , m_updateRequired(true)
    , m_keepPacLed64UpdaterAlive(false)
    , m_triggerUpdate(false)
+   , m_updateFailCount(0)
+   , m_updaterTaskState(UpdaterTaskState::Inactive)
    , m_forceFullUpdate(true)
 {
    std::fill(m_lastValueSent.begin(), m_lastValueSent.end(), 255);
+   m_commandBucket.Configure(std::chrono::milliseconds(10));
 }
 
 PacLed64::PacLed64Unit::~PacLed64Unit() { Finish(); }
@@ -260,6 +264,12 @@ void PacLed64::PacLed64Unit::UpdateValue(IOutput* output)
 
 void PacLed64::PacLed64Unit::TriggerPacLed64UpdaterThread()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Signal(this);
+      return;
+   }
+
    {
       std::lock_guard<std::mutex> lock(m_pacLed64UpdaterThreadLocker);
       m_triggerUpdate = true;
@@ -273,9 +283,9 @@ void PacLed64::PacLed64Unit::ShutdownLighting()
 {
    if (IsPresent())
    {
-      EnforceMinUpdateInterval();
+      WaitForCommandSlot();
       PacDriveSingleton::GetInstance().PacLed64SetLEDStates(0, 0, 0);
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      std::this_thread::sleep_until(m_commandBucket.GetNextTokenTime());
       std::fill(m_lastStateSent.begin(), m_lastStateSent.end(), false);
    }
 }
@@ -285,6 +295,15 @@ void PacLed64::PacLed64Unit::StartPacLed64UpdaterThread()
    std::lock_guard<std::mutex> lock(m_pacLed64UpdaterThreadLocker);
    if (!IsUpdaterThreadAlive())
    {
+      m_updateFailCount = 0;
+      OutputUpdateExecutor& executor = OutputUpdateExecutor::GetInstance();
+      if (!executor.IsThreadPerDevice())
+      {
+         m_updaterTaskState = UpdaterTaskState::Starting;
+         executor.Register(this);
+         return;
+      }
+
       m_keepPacLed64UpdaterAlive = true;
       m_updaterThreadFinished = false;
       m_pacLed64Updater = std::thread(&PacLed64Unit::PacLed64UpdaterDoIt, this);
@@ -293,6 +312,13 @@ void PacLed64::PacLed64Unit::StartPacLed64UpdaterThread()
 
 void PacLed64::PacLed64Unit::TerminatePacLed64UpdaterThread()
 {
+   if (m_updaterTaskState != UpdaterTaskState::Inactive)
+   {
+      OutputUpdateExecutor::GetInstance().Unregister(this);
+      m_updaterTaskState = UpdaterTaskState::Inactive;
+      return;
+   }
+
    {
       std::lock_guard<std::mutex> lock(m_pacLed64UpdaterThreadLocker);
       m_keepPacLed64UpdaterAlive = false;
@@ -328,34 +354,19 @@ void PacLed64::PacLed64Unit::PacLed64UpdaterDoIt()
       return;
    }
 
-   int failCount = 0;
    while (m_keepPacLed64UpdaterAlive)
    {
-      try
-      {
-         if (IsPresent())
-         {
-            SendPacLed64Update();
-         }
-         failCount = 0;
-      }
-      catch (const std::exception& e)
-      {
-         Log::Exception(StringExtensions::Build("Error occurred when updating PacLed64 {0}: {1}", std::to_string(m_id), e.what()));
-         failCount++;
-
-         if (failCount > MAX_UPDATE_FAIL_COUNT)
-         {
-            Log::Exception(StringExtensions::Build(
-               "More than {0} consecutive updates failed for PacLed64 {1}. Updater thread will terminate.", std::to_string(MAX_UPDATE_FAIL_COUNT), std::to_string(m_id)));
-            m_keepPacLed64UpdaterAlive = false;
-         }
-      }
+      if (!SendUpdateCountingFailures())
+         m_keepPacLed64UpdaterAlive = false;
 
       if (m_keepPacLed64UpdaterAlive)
       {
+         // A deferred update is resumed at the next token time with the values current by then, earlier triggers cannot send anything.
          std::unique_lock<std::mutex> lock(m_pacLed64UpdaterThreadLocker);
-         m_updateCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return m_triggerUpdate.load() || !m_keepPacLed64UpdaterAlive; });
+         if (m_commandDeferred)
+            m_updateCondition.wait_until(lock, m_commandBucket.GetNextTokenTime(), [this] { return !m_keepPacLed64UpdaterAlive; });
+         else
+            m_updateCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return m_triggerUpdate.load() || !m_keepPacLed64UpdaterAlive; });
       }
       m_triggerUpdate = false;
    }
@@ -370,6 +381,7 @@ void PacLed64::PacLed64Unit::SendPacLed64Update()
    std::lock_guard<std::mutex> updateLock(m_pacLed64UpdateLocker);
    std::lock_guard<std::mutex> valueLock(m_valueChangeLocker);
 
+   m_commandDeferred = false;
    if (!m_updateRequired && !m_forceFullUpdate)
       return;
 
@@ -410,9 +422,9 @@ void PacLed64::PacLed64Unit::SendPacLed64Update()
 
    if (m_forceFullUpdate || (intensityUpdatesRequired + stateUpdatesRequired) > m_fullUpdateThreshold)
    {
-      EnforceMinUpdateInterval();
+      if (!TryAcquireCommandSlot())
+         return;
       PacDriveSingleton::GetInstance().PacLed64SetLEDIntensities(m_index, m_currentValue.data());
-      m_lastCommand = std::chrono::steady_clock::now();
 
       m_lastValueSent = m_currentValue;
       for (int i = 0; i < 64; i++)
@@ -423,9 +435,11 @@ void PacLed64::PacLed64Unit::SendPacLed64Update()
    }
    else
    {
+      // Sent commands are recorded per output, so an update deferred for lack of a command slot resumes where it stopped.
       for (int g = 0; g < 8; g++)
       {
          int mask = 0;
+         int stateOffMask = 0;
          bool stateUpdateRequired = false;
 
          for (int p = 0; p < 8; p++)
@@ -435,9 +449,9 @@ void PacLed64::PacLed64Unit::SendPacLed64Update()
             {
                if (m_currentValue[o] != m_lastValueSent[o])
                {
-                  EnforceMinUpdateInterval();
+                  if (!TryAcquireCommandSlot())
+                     return;
                   PacDriveSingleton::GetInstance().PacLed64SetLEDIntensity(m_index, o, m_currentValue[o]);
-                  m_lastCommand = std::chrono::steady_clock::now();
 
                   m_lastStateSent[o] = true;
                   m_lastValueSent[o] = m_currentValue[o];
@@ -446,22 +460,34 @@ void PacLed64::PacLed64Unit::SendPacLed64Update()
                {
                   mask |= (1 << p);
                   stateUpdateRequired = true;
-                  m_lastStateSent[o] = true;
                }
             }
             else if (m_lastStateSent[o])
             {
+               stateOffMask |= (1 << p);
                stateUpdateRequired = true;
-               m_lastStateSent[o] = false;
-               m_lastValueSent[o] = 0;
             }
          }
 
          if (stateUpdateRequired)
          {
-            EnforceMinUpdateInterval();
+            if (!TryAcquireCommandSlot())
+               return;
             PacDriveSingleton::GetInstance().PacLed64SetLEDStates(m_index, g + 1, static_cast<uint8_t>(mask));
-            m_lastCommand = std::chrono::steady_clock::now();
+
+            for (int p = 0; p < 8; p++)
+            {
+               int o = (g << 3) | p;
+               if (mask & (1 << p))
+               {
+                  m_lastStateSent[o] = true;
+               }
+               else if (stateOffMask & (1 << p))
+               {
+                  m_lastStateSent[o] = false;
+                  m_lastValueSent[o] = 0;
+               }
+            }
          }
       }
    }
@@ -471,28 +497,24 @@ void PacLed64::PacLed64Unit::CopyNewToCurrent() { m_currentValue = m_newValue; }
 
 void PacLed64::PacLed64Unit::ResetFadeTime()
 {
-   EnforceMinUpdateInterval();
+   WaitForCommandSlot();
    PacDriveSingleton::GetInstance().PacLed64SetLEDFadeTime(m_index, 0);
-   m_lastCommand = std::chrono::steady_clock::now();
 }
 
-void PacLed64::PacLed64Unit::EnforceMinUpdateInterval()
+bool PacLed64::PacLed64Unit::TryAcquireCommandSlot()
 {
-   if (m_minUpdateInterval == std::chrono::milliseconds::zero())
-      return;
+   if (m_commandBucket.TryConsume(std::chrono::steady_clock::now()))
+      return true;
 
-   auto now = std::chrono::steady_clock::now();
-   auto elapsed = now - m_lastCommand;
+   m_commandDeferred = true;
+   m_updateRequired = true;
+   return false;
+}
 
-   if (elapsed < m_minUpdateInterval)
-   {
-      auto sleepTime = m_minUpdateInterval - elapsed;
-      if (sleepTime > std::chrono::milliseconds::zero() && sleepTime <= std::chrono::milliseconds(1000))
-      {
-         std::this_thread::sleep_for(sleepTime);
-      }
-   }
-   m_lastCommand = std::chrono::steady_clock::now();
+void PacLed64::PacLed64Unit::WaitForCommandSlot()
+{
+   std::this_thread::sleep_until(m_commandBucket.GetNextTokenTime());
+   m_commandBucket.TryConsume(std::chrono::steady_clock::now());
 }
 
 void PacLed64::PacLed64Unit::InitUnit()
@@ -505,6 +527,61 @@ void PacLed64::PacLed64Unit::InitUnit()
    }
 }
 
-bool PacLed64::PacLed64Unit::IsUpdaterThreadAlive() const { return m_pacLed64Updater.joinable(); }
+bool PacLed64::PacLed64Unit::IsUpdaterThreadAlive() const { return m_pacLed64Updater.joinable() || m_updaterTaskState != UpdaterTaskState::Inactive; }
+
+bool PacLed64::PacLed64Unit::SendUpdateCountingFailures()
+{
+   try
+   {
+      if (IsPresent())
+      {
+         SendPacLed64Update();
+      }
+      m_updateFailCount = 0;
+   }
+   catch (const std::exception& e)
+   {
+      Log::Exception(StringExtensions::Build("Error occurred when updating PacLed64 {0}: {1}", std::to_string(m_id), e.what()));
+      m_updateFailCount++;
+
+      if (m_updateFailCount > MAX_UPDATE_FAIL_COUNT)
+      {
+         Log::Exception(StringExtensions::Build(
+            "More than {0} consecutive updates failed for PacLed64 {1}. Updater thread will terminate.", std::to_string(MAX_UPDATE_FAIL_COUNT), std::to_string(m_id)));
+         return false;
+      }
+   }
+   return true;
+}
+
+std::chrono::steady_clock::time_point PacLed64::PacLed64Unit::RunOutputUpdate()
+{
+   if (m_updaterTaskState == UpdaterTaskState::Starting)
+   {
+      try
+      {
+         ResetFadeTime();
+      }
+      catch (const std::exception& e)
+      {
+         Log::Exception(StringExtensions::Build("Exception occurred while setting fade time for PacLed64 {0} to 0: {1}", std::to_string(m_index), e.what()));
+         m_updaterTaskState = UpdaterTaskState::Stopped;
+         return std::chrono::steady_clock::time_point::max();
+      }
+      m_updaterTaskState = UpdaterTaskState::Running;
+   }
+
+   if (m_updaterTaskState != UpdaterTaskState::Running)
+      return std::chrono::steady_clock::time_point::max();
+
+   if (!SendUpdateCountingFailures())
+   {
+      m_updaterTaskState = UpdaterTaskState::Stopped;
+      return std::chrono::steady_clock::time_point::max();
+   }
+
+   // A deferred update is resumed at the next token time with the values current by then.
+   return m_commandDeferred ? m_commandBucket.GetNextTokenTime() : std::chrono::steady_clock::time_point::max();
+}
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "../OutputControllerBase.h"
 #include "../IOutputController.h"
+#include "../IOutputUpdateTask.h"
+#include "../../../general/TokenBucket.h"
 #include <hidapi/hidapi.h>
 #include <map>
 #include <memory>
@@ -58,7 +60,7 @@ private:
 
    void AddOutputs();
 
-   class PacLed64Unit
+   class PacLed64Unit : public IOutputUpdateTask
    {
    public:
       PacLed64Unit(int id);
@@ -66,7 +68,7 @@ private:
 
       int GetId() const { return m_id; }
       void SetFullUpdateThreshold(int value) { m_fullUpdateThreshold = value; }
-      void SetMinUpdateInterval(std::chrono::milliseconds interval) { m_minUpdateInterval = interval; }
+      void SetMinUpdateInterval(std::chrono::milliseconds interval) { m_commandBucket.Configure(interval); }
 
       void Init(Cabinet* cabinet);
       void Finish();
@@ -77,13 +79,15 @@ private:
 
       bool GetUpdateRequired() const { return m_updateRequired; }
 
+      virtual std::chrono::steady_clock::time_point RunOutputUpdate() override;
+
    private:
       static const int MAX_UPDATE_FAIL_COUNT = 5;
 
       int m_id;
       int m_fullUpdateThreshold;
-      std::chrono::milliseconds m_minUpdateInterval;
-      std::chrono::steady_clock::time_point m_lastCommand;
+      TokenBucket m_commandBucket;
+      bool m_commandDeferred;
       int m_index;
 
       std::vector<uint8_t> m_newValue;
@@ -100,6 +104,16 @@ private:
       std::mutex m_pacLed64UpdaterThreadLocker;
       std::condition_variable m_updateCondition;
       std::atomic<bool> m_triggerUpdate;
+      int m_updateFailCount;
+
+      enum class UpdaterTaskState
+      {
+         Inactive,
+         Starting,
+         Running,
+         Stopped
+      };
+      std::atomic<UpdaterTaskState> m_updaterTaskState;
 
 
       void StartPacLed64UpdaterThread();
@@ -108,9 +122,11 @@ private:
       void SendPacLed64Update();
       void CopyNewToCurrent();
       void ResetFadeTime();
-      void EnforceMinUpdateInterval();
+      bool TryAcquireCommandSlot();
+      void WaitForCommandSlot();
       void InitUnit();
       bool IsUpdaterThreadAlive() const;
+      bool SendUpdateCountingFailures();
 
       std::atomic<bool> m_forceFullUpdate;
       std::atomic<bool> m_updaterThreadFinished { false };
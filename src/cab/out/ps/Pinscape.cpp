@@ -6,7 +6,6 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
-#include <thread>
 
 #include "../../../Log.h"
 #include "../../../general/StringExtensions.h"
@@ -30,7 +29,6 @@ Pinscape::Pinscape()
    m_number = -1;
    m_minCommandIntervalMs = 1;
    m_minCommandIntervalMsSet = false;
-   m_lastUpdate = std::chrono::steady_clock::now();
 }
 
 Pinscape::Pinscape(int value)
@@ -98,6 +96,7 @@ void Pinscape::Init(Cabinet* cabinet)
       }
    }
 
+   SetMinCommandInterval(std::chrono::milliseconds(m_minCommandIntervalMs));
    OutputControllerFlexCompleteBase::Init(cabinet);
 }
 
@@ -134,42 +133,54 @@ void Pinscape::UpdateOutputs(const std::vector<uint8_t>& newOutputValues)
    if (!m_dev)
       return;
 
-   uint8_t pfx = 200;
-   for (int i = 0; i < GetNumberOfOutputs(); i += 7, ++pfx)
+   for (int i = 0; i < GetNumberOfOutputs(); i += 7)
    {
-      int lim = std::min(i + 7, GetNumberOfOutputs());
-      for (int j = i; j < lim; ++j)
-      {
-         if (j < static_cast<int>(newOutputValues.size()) && newOutputValues[j] != m_oldOutputValues[j])
-         {
-            UpdateDelay();
-
-            uint8_t buf[9] = { 0 };
-            buf[0] = 0;
-            buf[1] = pfx;
-
-            int copySize = std::min(lim - i, static_cast<int>(newOutputValues.size()) - i);
-            memcpy(buf + 2, newOutputValues.data() + i, copySize);
-
-            m_dev->WriteUSB(buf);
+      if (!UpdateOutputGroup(newOutputValues, i))
+         return;
+   }
+}
 
-            memcpy(m_oldOutputValues.data() + i, newOutputValues.data() + i, copySize);
+void Pinscape::UpdateOutputs(const std::vector<uint8_t>& newOutputValues, const std::vector<OutputValueRange>& changedRanges)
+{
+   if (!m_dev)
+      return;
 
-            break;
-         }
+   for (const OutputValueRange& range : changedRanges)
+   {
+      int end = std::min(range.first + range.count, GetNumberOfOutputs());
+      for (int i = (range.first / 7) * 7; i < end; i += 7)
+      {
+         if (!UpdateOutputGroup(newOutputValues, i))
+            return;
       }
    }
 }
 
-void Pinscape::UpdateDelay()
+bool Pinscape::UpdateOutputGroup(const std::vector<uint8_t>& newOutputValues, int firstOutput)
 {
-   auto now = std::chrono::steady_clock::now();
-   auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastUpdate).count();
+   int lim = std::min(firstOutput + 7, GetNumberOfOutputs());
+   for (int j = firstOutput; j < lim; ++j)
+   {
+      if (j < static_cast<int>(newOutputValues.size()) && newOutputValues[j] != m_oldOutputValues[j])
+      {
+         if (!TryAcquireCommandSlot())
+            return false;
+
+         uint8_t buf[9] = { 0 };
+         buf[0] = 0;
+         buf[1] = static_cast<uint8_t>(200 + firstOutput / 7);
 
-   if (elapsed < m_minCommandIntervalMs)
-      std::this_thread::sleep_for(std::chrono::milliseconds(m_minCommandIntervalMs - elapsed));
+         int copySize = std::min(lim - firstOutput, static_cast<int>(newOutputValues.size()) - firstOutput);
+         memcpy(buf + 2, newOutputValues.data() + firstOutput, copySize);
 
-   m_lastUpdate = now;
+         m_dev->WriteUSB(buf);
+
+         memcpy(m_oldOutputValues.data() + firstOutput, newOutputValues.data() + firstOutput, copySize);
+
+         break;
+      }
+   }
+   return true;
 }
 
 void Pinscape::FindDevices()
@@ -29,6 +29,7 @@ public:
    virtual void ConnectToController() override;
    virtual void DisconnectFromController() override;
    virtual void UpdateOutputs(const std::vector<uint8_t>& outputValues) override;
+   virtual void UpdateOutputs(const std::vector<uint8_t>& outputValues, const std::vector<OutputValueRange>& changedRanges) override;
 
 protected:
    virtual int GetNumberOfConfiguredOutputs() override;
@@ -36,7 +37,6 @@ protected:
 public:
    int GetNumberOfOutputs() const;
    void AllOff();
-   void UpdateDelay();
    static void FindDevices();
    static void ClearDevices();
    static std::vector<void*> GetAllDevices();
@@ -74,12 +74,12 @@ private:
    };
 
    static std::string GetDeviceProductName(hid_device_info* dev);
+   bool UpdateOutputGroup(const std::vector<uint8_t>& newOutputValues, int firstOutput);
 
    int m_number;
    int m_minCommandIntervalMs;
    bool m_minCommandIntervalMsSet;
    std::vector<uint8_t> m_oldOutputValues;
-   std::chrono::steady_clock::time_point m_lastUpdate;
    static std::vector<Device*> s_devices;
    Device* m_dev;
 };
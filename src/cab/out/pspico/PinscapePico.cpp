@@ -24,6 +24,20 @@
 namespace DOF
 {
 
+static std::string GetHexString(const uint8_t* buf, size_t length)
+{
+   std::string hexString;
+   for (size_t i = 0; i < length; ++i)
+   {
+      if (i > 0)
+         hexString += ", ";
+      char hexStr[4];
+      snprintf(hexStr, sizeof(hexStr), "%02X", buf[i]);
+      hexString += hexStr;
+   }
+   return hexString;
+}
+
 std::vector<PinscapePico::Device*> PinscapePico::s_devices = { };
 
 void PinscapePico::Initialize()
@@ -633,16 +647,7 @@ bool PinscapePico::Device::WriteUSB(const std::string& desc, uint8_t* buf, uint3
    if (!m_fp || !buf)
       return false;
 
-   std::string hexString;
-   for (size_t i = 0; i < m_outputReportLength; ++i)
-   {
-      if (i > 0)
-         hexString += ", ";
-      char hexStr[4];
-      snprintf(hexStr, sizeof(hexStr), "%02X", buf[i]);
-      hexString += hexStr;
-   }
-   Log::Instrumentation("PinscapePico", StringExtensions::Build("PS Pico Write {0} : {1}", { desc, hexString }));
+   DOF_INSTRUMENTATION("PinscapePico", StringExtensions::Build("PS Pico Write {0} : {1}", { desc, GetHexString(buf, m_outputReportLength) }));
 
    uint32_t actual = 0;
    for (int tries = 0; tries < 3; ++tries)
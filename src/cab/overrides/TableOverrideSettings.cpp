@@ -17,12 +17,16 @@ TableOverrideSettings* TableOverrideSettings::GetInstance()
    return m_instance;
 }
 
-TableOverrideSettings::TableOverrideSettings() { }
+TableOverrideSettings::TableOverrideSettings()
+   : m_generation(0)
+{
+}
 
 TableOverrideSettings::~TableOverrideSettings() { ClearSettings(); }
 
 void TableOverrideSettings::ActivateOverrides()
 {
+   m_generation++;
    for (auto* currentTableOverrideSetting : m_settings)
    {
       bool romMatch = ContainsString(currentTableOverrideSetting->GetRomList(), m_activeRomName);
@@ -107,7 +111,10 @@ IOutput* TableOverrideSettings::GetNewRecalculatedOutput(IOutput* currentOutput,
 void TableOverrideSettings::AddSetting(TableOverrideSetting* setting)
 {
    if (setting)
+   {
       m_settings.push_back(setting);
+      m_generation++;
+   }
 }
 
 void TableOverrideSettings::ClearSettings()
@@ -115,6 +122,7 @@ void TableOverrideSettings::ClearSettings()
    for (auto* setting : m_settings)
       delete setting;
    m_settings.clear();
+   m_generation++;
 }
 
 TableOverrideSetting* TableOverrideSettings::FindByName(const std::string& name)
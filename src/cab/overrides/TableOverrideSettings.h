@@ -23,6 +23,7 @@ public:
    void SetActiveRomName(const std::string& activeRomName) { m_activeRomName = activeRomName; }
 
    void ActivateOverrides();
+   unsigned int GetGeneration() const { return m_generation; }
 
    TableOverrideSettingDevice* GetActiveDevice(IOutput* currentOutput, bool recalculateOutputValue, int startingDeviceIndex, int currentDeviceIndex);
    IOutput* GetNewRecalculatedOutput(IOutput* currentOutput, int startingDeviceIndex, int currentDeviceIndex);
@@ -41,6 +42,7 @@ private:
    std::string m_activeTableName;
    std::string m_activeRomName;
    std::vector<TableOverrideSetting*> m_settings;
+   unsigned int m_generation;
 
    bool ContainsString(const std::vector<std::string>& list, const std::string& value) const;
    bool MatchesWildcard(const std::vector<std::string>& list, const std::string& value) const;
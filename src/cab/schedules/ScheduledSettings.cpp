@@ -101,6 +101,34 @@ ScheduledSettingDevice* ScheduledSettings::GetActiveSchedule(IOutput* currentOut
    if (std::find(cacheList.begin(), cacheList.end(), deviceID) != cacheList.end())
       return nullptr;
 
+   ScheduledSettingDevice* device = FindActiveDevice(deviceID, currentOutput->GetNumber(), now);
+   if (!device)
+      return nullptr;
+
+   if (recalculateOutputValue)
+   {
+      int outputPercent = device->GetOutputPercent();
+      if (outputPercent != 100)
+      {
+         int outputNumber = currentOutput->GetNumber();
+         int originalValue = currentOutput->GetOutput();
+         int newValue = (originalValue * outputPercent) / 100;
+         newValue = MathExtensions::Limit(newValue, 0, 255);
+
+         currentOutput->SetOutput(static_cast<uint8_t>(newValue));
+
+         Log::Debug("ScheduledSettings: Applied " + std::to_string(outputPercent) + "% strength to output " + std::to_string(outputNumber) + " on device " + std::to_string(deviceID)
+            + " (value: " + std::to_string(originalValue) + " -> " + std::to_string(newValue) + ")");
+      }
+   }
+
+   cacheList.push_back(deviceID);
+
+   return device;
+}
+
+ScheduledSettingDevice* ScheduledSettings::FindActiveDevice(int deviceID, int outputNumber, const std::chrono::system_clock::time_point& now) const
+{
    for (ScheduledSetting* scheduledSetting : *this)
    {
       if (!scheduledSetting || !scheduledSetting->IsEnabled())
@@ -109,8 +137,7 @@ ScheduledSettingDevice* ScheduledSettings::GetActiveSchedule(IOutput* currentOut
       if (!scheduledSetting->IsTimeInRange(now))
          continue;
 
-      const ScheduledSettingDeviceList& deviceList = scheduledSetting->GetScheduledSettingDeviceList();
-      for (ScheduledSettingDevice* device : deviceList)
+      for (ScheduledSettingDevice* device : scheduledSetting->GetScheduledSettingDeviceList())
       {
          if (!device)
             continue;
@@ -119,31 +146,8 @@ ScheduledSettingDevice* ScheduledSettings::GetActiveSchedule(IOutput* currentOut
             continue;
 
          const std::vector<int>& outputList = device->GetOutputList();
-         int outputNumber = currentOutput->GetNumber();
-
-         if (!outputList.empty())
-         {
-            if (std::find(outputList.begin(), outputList.end(), outputNumber) == outputList.end())
-               continue;
-         }
-
-         if (recalculateOutputValue)
-         {
-            int outputPercent = device->GetOutputPercent();
-            if (outputPercent != 100)
-            {
-               int originalValue = currentOutput->GetOutput();
-               int newValue = (originalValue * outputPercent) / 100;
-               newValue = MathExtensions::Limit(newValue, 0, 255);
-
-               currentOutput->SetOutput(static_cast<uint8_t>(newValue));
-
-               Log::Debug("ScheduledSettings: Applied " + std::to_string(outputPercent) + "% strength to output " + std::to_string(outputNumber) + " on device " + std::to_string(deviceID)
-                  + " (value: " + std::to_string(originalValue) + " -> " + std::to_string(newValue) + ")");
-            }
-         }
-
-         cacheList.push_back(deviceID);
+         if (!outputList.empty() && std::find(outputList.begin(), outputList.end(), outputNumber) == outputList.end())
+            continue;
 
          return device;
       }
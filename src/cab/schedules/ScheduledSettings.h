@@ -21,6 +21,7 @@ public:
    ScheduledSetting* GetActiveSchedule(const std::string& configPostfixID, int outputNumber) const;
    ScheduledSetting* GetActiveSchedule(const std::string& configPostfixID, int outputNumber, const std::chrono::system_clock::time_point& now) const;
    ScheduledSettingDevice* GetActiveSchedule(IOutput* currentOutput, bool recalculateOutputValue, int startingDeviceIndex, int currentDeviceIndex);
+   ScheduledSettingDevice* FindActiveDevice(int deviceID, int outputNumber, const std::chrono::system_clock::time_point& now) const;
 
    uint8_t GetNewRecalculatedOutput(const std::string& configPostfixID, int outputNumber, uint8_t originalOutput) const;
    uint8_t GetNewRecalculatedOutput(const std::string& configPostfixID, int outputNumber, uint8_t originalOutput, const std::chrono::system_clock::time_point& now) const;
@@ -2,6 +2,8 @@
 
 #include "IToy.h"
 
+#include <algorithm>
+
 namespace DOF
 {
 
@@ -14,8 +16,81 @@ public:
    virtual int GetHeight() const = 0;
    virtual int GetWidth() const = 0;
    virtual int GetElementCount() const { return GetWidth() * GetHeight(); }
+   virtual int GetLayerStride() const { return GetWidth(); }
    virtual MatrixElementType GetElement(int layerNr, int x, int y) = 0;
    virtual void SetElement(int layerNr, int x, int y, const MatrixElementType& value) = 0;
+   virtual void WriteRow(int layerNr, int x, int y, const MatrixElementType* values, int count);
+   virtual void FillRow(int layerNr, int x, int y, int count, const MatrixElementType& value);
+   virtual void MarkDirty(int /*left*/, int /*top*/, int /*width*/, int /*height*/) { }
 };
 
+template <typename MatrixElementType> void IMatrixToy<MatrixElementType>::WriteRow(int layerNr, int x, int y, const MatrixElementType* values, int count)
+{
+   if (y < 0 || y >= GetHeight())
+      return;
+
+   int first = std::max(x, 0);
+   int last = std::min(x + count, GetWidth()) - 1;
+   if (first > last)
+      return;
+
+   MatrixElementType* layer = GetLayer(layerNr);
+   if (layer == nullptr)
+   {
+      for (int i = first; i <= last; i++)
+         SetElement(layerNr, i, y, values[i - x]);
+      return;
+   }
+
+   // Only the changed part of the row is marked dirty, like SetElement does for single elements.
+   MatrixElementType* row = layer + y * GetLayerStride();
+   int firstChanged = last + 1;
+   int lastChanged = first - 1;
+   for (int i = first; i <= last; i++)
+   {
+      if (row[i] != values[i - x])
+      {
+         row[i] = values[i - x];
+         firstChanged = std::min(firstChanged, i);
+         lastChanged = i;
+      }
+   }
+   if (firstChanged <= lastChanged)
+      MarkDirty(firstChanged, y, lastChanged - firstChanged + 1, 1);
+}
+
+template <typename MatrixElementType> void IMatrixToy<MatrixElementType>::FillRow(int layerNr, int x, int y, int count, const MatrixElementType& value)
+{
+   if (y < 0 || y >= GetHeight())
+      return;
+
+   int first = std::max(x, 0);
+   int last = std::min(x + count, GetWidth()) - 1;
+   if (first > last)
+      return;
+
+   MatrixElementType* layer = GetLayer(layerNr);
+   if (layer == nullptr)
+   {
+      for (int i = first; i <= last; i++)
+         SetElement(layerNr, i, y, value);
+      return;
+   }
+
+   MatrixElementType* row = layer + y * GetLayerStride();
+   int firstChanged = last + 1;
+   int lastChanged = first - 1;
+   for (int i = first; i <= last; i++)
+   {
+      if (row[i] != value)
+      {
+         row[i] = value;
+         firstChanged = std::min(firstChanged, i);
+         lastChanged = i;
+      }
+   }
+   if (firstChanged <= lastChanged)
+      MarkDirty(firstChanged, y, lastChanged - firstChanged + 1, 1);
+}
+
 }
\ No newline at end of file
@@ -6,7 +6,8 @@
 #include "../../Cabinet.h"
 #include "../../overrides/TableOverrideSettings.h"
 #include "../../schedules/ScheduledSettings.h"
-#include "../layer/AlphaMappingTable.h"
+#include "../../schedules/ScheduledSettingDevice.h"
+#include "../layer/RGBALayerBlender.h"
 #include "../lwequivalent/LedWizEquivalent.h"
 #include "../ToyList.h"
 #include "../../../general/MathExtensions.h"
@@ -15,8 +16,9 @@
 #include "../../../general/CurveList.h"
 #include <tinyxml2/tinyxml2.h>
 #include <algorithm>
-#include <array>
+#include <chrono>
 #include <cmath>
+#include <climits>
 #include <cstring>
 #include <vector>
 
@@ -36,6 +38,11 @@ LedStrip::LedStrip()
    , m_outputControllerName("")
    , m_outputController(nullptr)
    , m_layers()
+   , m_ledWizNumber(-1)
+   , m_outputLevel(100)
+   , m_outputLevelOverrideGeneration(0)
+   , m_outputTablePercent(-1)
+   , m_outputTableBrightness(0.0f)
    , m_cabinet(nullptr)
 {
 }
@@ -147,8 +154,25 @@ void LedStrip::Init(Cabinet* cabinet)
       }
    }
 
+   m_ledWizNumber = -1;
+   if (cabinet != nullptr && cabinet->GetToys() != nullptr)
+   {
+      for (IToy* toy : *cabinet->GetToys())
+      {
+         LedWizEquivalent* lwe = dynamic_cast<LedWizEquivalent*>(toy);
+         if (lwe)
+         {
+            m_ledWizNumber = lwe->GetLedWizNumber();
+            break;
+         }
+      }
+   }
+   m_outputLevelOverrideGeneration = TableOverrideSettings::GetInstance()->GetGeneration() - 1;
+
    BuildMappingTables();
+   m_compositeData.assign(GetNumberOfLeds() * 4, 0);
    m_outputData.resize(GetNumberOfOutputs(), 0);
+   m_outputTablePercent = -1;
    InitFadingCurve(cabinet);
 
    m_layers = MatrixDictionaryBase<RGBAColor>();
@@ -160,8 +184,9 @@ void LedStrip::Reset()
 {
    if (m_outputController != nullptr && GetNumberOfLeds() > 0)
    {
-      std::vector<uint8_t> clearData(GetNumberOfLeds() * 3, 0);
-      m_outputController->SetValues((m_firstLedNumber - 1) * 3, clearData.data(), static_cast<int>(clearData.size()));
+      m_outputData.assign(GetNumberOfOutputs(), 0);
+      m_outputController->SetValues((m_firstLedNumber - 1) * 3, m_outputData.data(), static_cast<int>(m_outputData.size()));
+      m_layers.MarkAllDirty();
    }
 }
 
@@ -186,8 +211,10 @@ void LedStrip::UpdateOutputs()
 {
    if (m_outputController != nullptr && m_layers.size() > 0)
    {
-      SetOutputData();
-      m_outputController->SetValues((m_firstLedNumber - 1) * 3, m_outputData.data(), static_cast<int>(m_outputData.size()));
+      int firstChangedOutput;
+      int lastChangedOutput;
+      if (SetOutputData(firstChangedOutput, lastChangedOutput))
+         m_outputController->SetValues((m_firstLedNumber - 1) * 3 + firstChangedOutput, m_outputData.data() + firstChangedOutput, lastChangedOutput - firstChangedOutput + 1);
    }
 }
 
@@ -199,7 +226,43 @@ void LedStrip::SetElement(int layerNr, int x, int y, const RGBAColor& value) { m
 
 void LedStrip::BuildMappingTables()
 {
-   m_outputMappingTable.resize(m_width, std::vector<int>(m_height, 0));
+   int colorOffset[3];
+   switch (m_colorOrder)
+   {
+   case RGBOrderEnum::RBG:
+      colorOffset[0] = 0;
+      colorOffset[1] = 2;
+      colorOffset[2] = 1;
+      break;
+   case RGBOrderEnum::GRB:
+      colorOffset[0] = 1;
+      colorOffset[1] = 0;
+      colorOffset[2] = 2;
+      break;
+   case RGBOrderEnum::GBR:
+      colorOffset[0] = 1;
+      colorOffset[1] = 2;
+      colorOffset[2] = 0;
+      break;
+   case RGBOrderEnum::BRG:
+      colorOffset[0] = 2;
+      colorOffset[1] = 0;
+      colorOffset[2] = 1;
+      break;
+   case RGBOrderEnum::BGR:
+      colorOffset[0] = 2;
+      colorOffset[1] = 1;
+      colorOffset[2] = 0;
+      break;
+   case RGBOrderEnum::RGB:
+   default:
+      colorOffset[0] = 0;
+      colorOffset[1] = 1;
+      colorOffset[2] = 2;
+      break;
+   }
+
+   m_outputIndexTable.assign(GetNumberOfOutputs(), 0);
    int ledNr = 0;
 
    for (int y = 0; y < m_height; y++)
@@ -226,7 +289,10 @@ void LedStrip::BuildMappingTables()
          case LedStripArrangementEnum::BottomUpAlternateRightLeft: ledNr = (m_height * (m_width - 1 - x)) + ((x & 1) == 0 ? y : (m_height - 1 - y)); break;
          default: ledNr = (y * m_width) + x; break;
          }
-         m_outputMappingTable[x][y] = ledNr * 3;
+         int nr = ((y * m_width) + x) * 3;
+         m_outputIndexTable[nr] = ledNr * 3 + colorOffset[0];
+         m_outputIndexTable[nr + 1] = ledNr * 3 + colorOffset[1];
+         m_outputIndexTable[nr + 2] = ledNr * 3 + colorOffset[2];
       }
    }
 }
@@ -271,166 +337,83 @@ Curve LedStrip::GetFadingTableFromPercent(int outputPercent) const
    }
 }
 
-void LedStrip::SetOutputData()
+void LedStrip::UpdateOutputLevel()
 {
-   if (m_layers.size() > 0)
+   // Overrides only change when they are activated and schedules have a resolution of one minute,
+   // so the output level of the strip is cached until either of these happens.
+   auto now = std::chrono::system_clock::now();
+   m_outputLevelOverrideGeneration = TableOverrideSettings::GetInstance()->GetGeneration();
+   m_outputLevelValidUntil = ScheduledSettings::GetInstance().empty() ? std::chrono::system_clock::time_point::max() : std::chrono::floor<std::chrono::minutes>(now) + std::chrono::minutes(1);
+
+   Output newOutput;
+   newOutput.SetNumber(m_firstLedNumber);
+   newOutput.SetOutput(100);
+
+   if (m_ledWizNumber >= 0)
    {
-      if (m_brightness == 0.0f)
+      TableOverrideSettings::GetInstance()->GetActiveDevice(&newOutput, true, 30, m_ledWizNumber - 30);
+
+      if (newOutput.GetOutput() != 0)
       {
-         std::fill(m_outputData.begin(), m_outputData.end(), 0);
-         return;
+         ScheduledSettingDevice* scheduledDevice = ScheduledSettings::GetInstance().FindActiveDevice(m_ledWizNumber, m_firstLedNumber, now);
+         if (scheduledDevice)
+            newOutput.SetOutput(static_cast<uint8_t>(MathExtensions::Limit((newOutput.GetOutput() * scheduledDevice->GetOutputPercent()) / 100, 0, 255)));
       }
+   }
 
-      std::array<float, 3> defaultValue = { { 0.0f, 0.0f, 0.0f } };
-      std::vector<std::vector<std::array<float, 3>>> value(m_width, std::vector<std::array<float, 3>>(m_height, defaultValue));
-
-      for (const auto& kv : m_layers)
-      {
-         RGBAColor* d = kv.second;
+   m_outputLevel = newOutput.GetOutput();
+}
 
-         int nr = 0;
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int alpha = MathExtensions::Limit(d[nr].GetAlpha(), 0, 255);
-               if (alpha != 0)
-               {
-                  value[x][y][0]
-                     = AlphaMappingTable::AlphaMapping[255 - alpha][static_cast<int>(value[x][y][0])] + AlphaMappingTable::AlphaMapping[alpha][MathExtensions::Limit(d[nr].GetRed(), 0, 255)];
-                  value[x][y][1] = AlphaMappingTable::AlphaMapping[255 - alpha][static_cast<int>(value[x][y][1])]
-                     + AlphaMappingTable::AlphaMapping[alpha][MathExtensions::Limit(d[nr].GetGreen(), 0, 255)];
-                  value[x][y][2] = AlphaMappingTable::AlphaMapping[255 - alpha][static_cast<int>(value[x][y][2])]
-                     + AlphaMappingTable::AlphaMapping[alpha][MathExtensions::Limit(d[nr].GetBlue(), 0, 255)];
-               }
-               nr++;
-            }
-         }
-      }
+bool LedStrip::SetOutputData(int& firstChangedOutput, int& lastChangedOutput)
+{
+   firstChangedOutput = INT_MAX;
+   lastChangedOutput = -1;
 
-      const uint8_t* fadingTable = m_fadingCurve->GetData();
+   if (TableOverrideSettings::GetInstance()->GetGeneration() != m_outputLevelOverrideGeneration || std::chrono::system_clock::now() >= m_outputLevelValidUntil)
+      UpdateOutputLevel();
 
-      Output newOutput;
-      std::vector<LedWizEquivalent*> lweList;
-      if (m_cabinet && m_cabinet->GetToys())
-      {
-         ToyList* toys = m_cabinet->GetToys();
-         for (auto it = toys->begin(); it != toys->end(); ++it)
-         {
-            LedWizEquivalent* lwe = dynamic_cast<LedWizEquivalent*>(*it);
-            if (lwe)
-            {
-               lweList.push_back(lwe);
-            }
-         }
-      }
-      LedWizEquivalent* lwe = lweList.empty() ? nullptr : lweList[0];
+   if (m_outputLevel != m_outputTablePercent || m_brightness != m_outputTableBrightness)
+   {
+      m_outputTablePercent = m_outputLevel;
+      m_outputTableBrightness = m_brightness;
 
-      newOutput.SetNumber(m_firstLedNumber);
-      newOutput.SetOutput(100);
+      Curve finalFadingTable = GetFadingTableFromPercent(m_outputTablePercent);
+      const uint8_t* fadingTable = finalFadingTable.GetData();
+      float correctedBrightness = m_brightness < 1.0f ? std::pow(m_brightness, m_brightnessGammaCorrection) : 1.0f;
+      for (int i = 0; i < 256; i++)
+         m_outputTable[i] = m_brightness < 1.0f ? static_cast<uint8_t>(fadingTable[i] * correctedBrightness) : fadingTable[i];
 
-      if (lwe)
-      {
-         IOutput* overriddenOutput = TableOverrideSettings::GetInstance()->GetNewRecalculatedOutput(&newOutput, 30, lwe->GetLedWizNumber() - 30);
-         newOutput.SetOutput(overriddenOutput->GetOutput());
-         if (overriddenOutput != &newOutput)
-            delete overriddenOutput;
-
-         IOutput* scheduledOutput = ScheduledSettings::GetInstance().GetNewRecalculatedOutput(&newOutput, 30, lwe->GetLedWizNumber() - 30);
-         newOutput.SetOutput(scheduledOutput->GetOutput());
-         if (scheduledOutput != &newOutput)
-            delete scheduledOutput;
-      }
+      m_layers.MarkAllDirty();
+   }
 
-      Curve finalFadingTable = GetFadingTableFromPercent(newOutput.GetOutput());
-      fadingTable = finalFadingTable.GetData();
+   if (!m_layers.IsDirty())
+      return false;
 
-      switch (m_colorOrder)
-      {
-      case RGBOrderEnum::RBG:
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int outputNumber = m_outputMappingTable[x][y];
-               m_outputData[outputNumber] = fadingTable[static_cast<int>(value[x][y][0])];
-               m_outputData[outputNumber + 2] = fadingTable[static_cast<int>(value[x][y][1])];
-               m_outputData[outputNumber + 1] = fadingTable[static_cast<int>(value[x][y][2])];
-            }
-         }
-         break;
-      case RGBOrderEnum::GRB:
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int outputNumber = m_outputMappingTable[x][y];
-               m_outputData[outputNumber + 1] = fadingTable[static_cast<int>(value[x][y][0])];
-               m_outputData[outputNumber] = fadingTable[static_cast<int>(value[x][y][1])];
-               m_outputData[outputNumber + 2] = fadingTable[static_cast<int>(value[x][y][2])];
-            }
-         }
-         break;
-      case RGBOrderEnum::GBR:
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int outputNumber = m_outputMappingTable[x][y];
-               m_outputData[outputNumber + 1] = fadingTable[static_cast<int>(value[x][y][0])];
-               m_outputData[outputNumber + 2] = fadingTable[static_cast<int>(value[x][y][1])];
-               m_outputData[outputNumber] = fadingTable[static_cast<int>(value[x][y][2])];
-            }
-         }
-         break;
-      case RGBOrderEnum::BRG:
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int outputNumber = m_outputMappingTable[x][y];
-               m_outputData[outputNumber + 2] = fadingTable[static_cast<int>(value[x][y][0])];
-               m_outputData[outputNumber] = fadingTable[static_cast<int>(value[x][y][1])];
-               m_outputData[outputNumber + 1] = fadingTable[static_cast<int>(value[x][y][2])];
-            }
-         }
-         break;
-      case RGBOrderEnum::BGR:
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int outputNumber = m_outputMappingTable[x][y];
-               m_outputData[outputNumber + 2] = fadingTable[static_cast<int>(value[x][y][0])];
-               m_outputData[outputNumber + 1] = fadingTable[static_cast<int>(value[x][y][1])];
-               m_outputData[outputNumber] = fadingTable[static_cast<int>(value[x][y][2])];
-            }
-         }
-         break;
-      case RGBOrderEnum::RGB:
-      default:
-         for (int y = 0; y < m_height; y++)
-         {
-            for (int x = 0; x < m_width; x++)
-            {
-               int outputNumber = m_outputMappingTable[x][y];
-               m_outputData[outputNumber] = fadingTable[static_cast<int>(value[x][y][0])];
-               m_outputData[outputNumber + 1] = fadingTable[static_cast<int>(value[x][y][1])];
-               m_outputData[outputNumber + 2] = fadingTable[static_cast<int>(value[x][y][2])];
-            }
-         }
-         break;
-      }
+   int left = m_layers.GetDirtyLeft();
+   int width = m_layers.GetDirtyRight() - left + 1;
+   for (int y = m_layers.GetDirtyTop(); y <= m_layers.GetDirtyBottom(); y++)
+   {
+      int nr = y * m_width + left;
+      std::fill(m_compositeData.begin() + nr * 4, m_compositeData.begin() + (nr + width) * 4, 0);
+      for (const auto& kv : m_layers)
+         RGBALayerBlender::BlendLayer(m_compositeData.data() + nr * 4, kv.second + nr, width);
 
-      if (m_brightness < 1.0f)
+      const uint16_t* compositeData = m_compositeData.data() + nr * 4;
+      const int* outputIndex = m_outputIndexTable.data() + nr * 3;
+      for (int x = 0; x < width * 3; x++)
       {
-         float correctedBrightness = std::pow(m_brightness, m_brightnessGammaCorrection);
-         for (int num = 0; num < static_cast<int>(m_outputData.size()); ++num)
+         uint8_t value = m_outputTable[compositeData[x + x / 3]];
+         if (m_outputData[outputIndex[x]] != value)
          {
-            m_outputData[num] = static_cast<uint8_t>(m_outputData[num] * correctedBrightness);
+            m_outputData[outputIndex[x]] = value;
+            firstChangedOutput = std::min(firstChangedOutput, outputIndex[x]);
+            lastChangedOutput = std::max(lastChangedOutput, outputIndex[x]);
          }
       }
    }
+
+   m_layers.ClearDirty();
+   return lastChangedOutput >= 0;
 }
 
 tinyxml2::XMLElement* LedStrip::ToXml(tinyxml2::XMLDocument& doc) const
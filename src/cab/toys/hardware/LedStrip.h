@@ -8,6 +8,7 @@
 #include "../../../general/color/RGBAColor.h"
 #include "../../../general/Curve.h"
 #include <tinyxml2/tinyxml2.h>
+#include <chrono>
 #include <vector>
 #include <string>
 #include <memory>
@@ -57,6 +58,7 @@ public:
    virtual RGBAColor* GetLayer(int layerNr) override;
    virtual RGBAColor GetElement(int layerNr, int x, int y) override;
    virtual void SetElement(int layerNr, int x, int y, const RGBAColor& value) override;
+   virtual void MarkDirty(int left, int top, int width, int height) override { m_layers.MarkDirty(left, top, width, height); }
 
    virtual tinyxml2::XMLElement* ToXml(tinyxml2::XMLDocument& doc) const;
    virtual bool FromXml(const tinyxml2::XMLElement* element);
@@ -79,17 +81,23 @@ private:
    ISupportsSetValues* m_outputController;
 
    MatrixDictionaryBase<RGBAColor> m_layers;
-   std::vector<std::vector<int>> m_outputMappingTable;
+   std::vector<int> m_outputIndexTable;
+   std::vector<uint16_t> m_compositeData;
    std::vector<uint8_t> m_outputData;
+   int m_ledWizNumber;
+   int m_outputLevel;
+   unsigned int m_outputLevelOverrideGeneration;
+   std::chrono::system_clock::time_point m_outputLevelValidUntil;
+   uint8_t m_outputTable[256];
+   int m_outputTablePercent;
+   float m_outputTableBrightness;
    Cabinet* m_cabinet;
 
    void InitFadingCurve(Cabinet* cabinet);
    void BuildMappingTables();
    Curve GetFadingTableFromPercent(int outputPercent) const;
-   void SetOutputData();
-   int CalculateLedNumber(int x, int y) const;
-   void ApplyColorOrder(uint8_t& r, uint8_t& g, uint8_t& b) const;
-   uint8_t ApplyFadingCurve(uint8_t value) const;
+   void UpdateOutputLevel();
+   bool SetOutputData(int& firstChangedOutput, int& lastChangedOutput);
 };
 
 }
\ No newline at end of file
@@ -26,9 +26,22 @@ public:
    void SetElement(int layerNr, int x, int y, const MatrixElementType& value);
    void Clear();
 
+   void MarkDirty(int left, int top, int width, int height);
+   void MarkAllDirty() { MarkDirty(0, 0, m_width, m_height); }
+   void ClearDirty();
+   bool IsDirty() const { return m_dirtyLeft <= m_dirtyRight; }
+   int GetDirtyLeft() const { return m_dirtyLeft; }
+   int GetDirtyTop() const { return m_dirtyTop; }
+   int GetDirtyRight() const { return m_dirtyRight; }
+   int GetDirtyBottom() const { return m_dirtyBottom; }
+
 private:
    int m_width;
    int m_height;
+   int m_dirtyLeft;
+   int m_dirtyTop;
+   int m_dirtyRight;
+   int m_dirtyBottom;
 
    MatrixElementType* CreateLayer();
    int GetIndex(int x, int y) const { return y * m_width + x; }
@@ -38,6 +51,10 @@ template <typename MatrixElementType>
 MatrixDictionaryBase<MatrixElementType>::MatrixDictionaryBase()
    : m_width(1)
    , m_height(1)
+   , m_dirtyLeft(0)
+   , m_dirtyTop(0)
+   , m_dirtyRight(0)
+   , m_dirtyBottom(0)
 {
 }
 
@@ -45,6 +62,10 @@ template <typename MatrixElementType>
 MatrixDictionaryBase<MatrixElementType>::MatrixDictionaryBase(int width, int height)
    : m_width(MathExtensions::Limit(width, 1, INT_MAX))
    , m_height(MathExtensions::Limit(height, 1, INT_MAX))
+   , m_dirtyLeft(0)
+   , m_dirtyTop(0)
+   , m_dirtyRight(m_width - 1)
+   , m_dirtyBottom(m_height - 1)
 {
 }
 
@@ -71,6 +92,7 @@ template <typename MatrixElementType> MatrixElementType* MatrixDictionaryBase<Ma
 
    MatrixElementType* newLayer = CreateLayer();
    (*this)[layerNr] = newLayer;
+   MarkAllDirty();
    return newLayer;
 }
 
@@ -85,6 +107,7 @@ template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementTyp
 
    if (data != nullptr)
       (*this)[layerNr] = data;
+   MarkAllDirty();
 }
 
 template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementType>::SetWidth(int value)
@@ -94,6 +117,7 @@ template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementTyp
    {
       Clear();
       m_width = newWidth;
+      MarkAllDirty();
    }
 }
 
@@ -104,6 +128,7 @@ template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementTyp
    {
       Clear();
       m_height = newHeight;
+      MarkAllDirty();
    }
 }
 
@@ -124,8 +149,11 @@ template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementTyp
       return;
 
    MatrixElementType* layer = GetOrCreateLayer(layerNr);
-   if (layer != nullptr)
+   if (layer != nullptr && layer[GetIndex(x, y)] != value)
+   {
       layer[GetIndex(x, y)] = value;
+      MarkDirty(x, y, 1, 1);
+   }
 }
 
 template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementType>::Clear()
@@ -133,6 +161,40 @@ template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementTyp
    for (auto& pair : *this)
       delete[] pair.second;
    std::map<int, MatrixElementType*>::clear();
+   MarkAllDirty();
+}
+
+template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementType>::MarkDirty(int left, int top, int width, int height)
+{
+   int right = std::min(left + width, m_width) - 1;
+   int bottom = std::min(top + height, m_height) - 1;
+   left = std::max(left, 0);
+   top = std::max(top, 0);
+   if (left > right || top > bottom)
+      return;
+
+   if (IsDirty())
+   {
+      m_dirtyLeft = std::min(m_dirtyLeft, left);
+      m_dirtyTop = std::min(m_dirtyTop, top);
+      m_dirtyRight = std::max(m_dirtyRight, right);
+      m_dirtyBottom = std::max(m_dirtyBottom, bottom);
+   }
+   else
+   {
+      m_dirtyLeft = left;
+      m_dirtyTop = top;
+      m_dirtyRight = right;
+      m_dirtyBottom = bottom;
+   }
+}
+
+template <typename MatrixElementType> void MatrixDictionaryBase<MatrixElementType>::ClearDirty()
+{
+   m_dirtyLeft = 0;
+   m_dirtyTop = 0;
+   m_dirtyRight = -1;
+   m_dirtyBottom = -1;
 }
 
 template <typename MatrixElementType> MatrixElementType* MatrixDictionaryBase<MatrixElementType>::CreateLayer()
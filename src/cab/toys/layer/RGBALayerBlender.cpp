@@ -0,0 +1,63 @@
+#include "RGBALayerBlender.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RGBALAYERBLENDER_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RGBALAYERBLENDER_NEON
+#endif
+
+namespace DOF
+{
+
+void RGBALayerBlender::BlendLayer(uint16_t* compositeData, const RGBAColor* layer, int count)
+{
+   static_assert(sizeof(RGBAColor) == 4, "RGBAColor is expected to hold red, green, blue and alpha as consecutive bytes");
+   const uint8_t* src = reinterpret_cast<const uint8_t*>(layer);
+   int nr = 0;
+
+   // compositeData holds 4 channels per led. Blending is composite = (composite * (255 - alpha) + color * alpha) / 255
+   // with the division done as (v + 1 + (v >> 8)) >> 8 which is exact for all values that can occur here.
+#if defined(RGBALAYERBLENDER_SSE2)
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i max = _mm_set1_epi16(255);
+   const __m128i one = _mm_set1_epi16(1);
+   for (; nr + 2 <= count; nr += 2)
+   {
+      __m128i color = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + nr * 4)), zero);
+      __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+      __m128i composite = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compositeData + nr * 4));
+      __m128i v = _mm_add_epi16(_mm_mullo_epi16(composite, _mm_sub_epi16(max, alpha)), _mm_mullo_epi16(color, alpha));
+      v = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(v, one), _mm_srli_epi16(v, 8)), 8);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(compositeData + nr * 4), v);
+   }
+#elif defined(RGBALAYERBLENDER_NEON)
+   const uint16x8_t max = vdupq_n_u16(255);
+   for (; nr + 2 <= count; nr += 2)
+   {
+      uint16x8_t color = vmovl_u8(vld1_u8(src + nr * 4));
+      uint16x8_t alpha = vcombine_u16(vdup_n_u16(vgetq_lane_u16(color, 3)), vdup_n_u16(vgetq_lane_u16(color, 7)));
+      uint16x8_t composite = vld1q_u16(compositeData + nr * 4);
+      uint16x8_t v = vmlaq_u16(vmulq_u16(composite, vsubq_u16(max, alpha)), color, alpha);
+      v = vshrq_n_u16(vaddq_u16(vaddq_u16(v, vdupq_n_u16(1)), vshrq_n_u16(v, 8)), 8);
+      vst1q_u16(compositeData + nr * 4, v);
+   }
+#endif
+
+   for (; nr < count; nr++)
+   {
+      int alpha = src[nr * 4 + 3];
+      if (alpha == 0)
+         continue;
+
+      uint16_t* composite = compositeData + nr * 4;
+      for (int i = 0; i < 3; i++)
+      {
+         int v = composite[i] * (255 - alpha) + src[nr * 4 + i] * alpha;
+         composite[i] = static_cast<uint16_t>((v + 1 + (v >> 8)) >> 8);
+      }
+   }
+}
+
+}
\ No newline at end of file
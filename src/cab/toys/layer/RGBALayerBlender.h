@@ -0,0 +1,19 @@
+#pragma once
+
+#include "../../../general/color/RGBAColor.h"
+#include <cstdint>
+
+namespace DOF
+{
+
+// Alpha blends RGBA layers into a composite buffer holding 4 uint16 channels per led, as used by LedStrip.
+class RGBALayerBlender
+{
+public:
+   static void BlendLayer(uint16_t* compositeData, const RGBAColor* layer, int count);
+
+private:
+   RGBALayerBlender() = delete;
+};
+
+}
\ No newline at end of file
@@ -18,6 +18,7 @@ public:
 
    const std::string& GetTargetEffectName() const { return m_targetEffectName; }
    void SetTargetEffectName(const std::string& value);
+   IEffect* GetTargetEffect() const { return m_targetEffect; }
 
    virtual void Init(Table* table) override;
    virtual void Finish() override;
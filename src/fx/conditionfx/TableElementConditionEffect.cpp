@@ -135,14 +135,9 @@ void TableElementConditionEffect::UpdateVariableValues()
       {
          std::string elementName = varName.substr(13);
 
-         for (TableElement* element : *tableElements)
-         {
-            if (element->GetName() == elementName)
-            {
-               varValue = static_cast<double>(element->GetValue());
-               break;
-            }
-         }
+         TableElement* element = tableElements->Find(elementName);
+         if (element)
+            varValue = static_cast<double>(element->GetValue());
       }
       else if (varName.length() >= 2)
       {
@@ -169,14 +164,9 @@ void TableElementConditionEffect::UpdateVariableValues()
          {
             int number = std::stoi(numberStr);
 
-            for (TableElement* element : *tableElements)
-            {
-               if (element->GetTableElementType() == elementType && element->GetNumber() == number)
-               {
-                  varValue = static_cast<double>(element->GetValue());
-                  break;
-               }
-            }
+            TableElement* element = tableElements->Find(elementType, number);
+            if (element)
+               varValue = static_cast<double>(element->GetValue());
          }
          catch (const std::exception&)
          {
@@ -0,0 +1,10 @@
+#include "MatrixAnimationFrameCache.h"
+#include "../../general/color/RGBAColor.h"
+#include "../../general/analog/AnalogAlpha.h"
+
+namespace DOF
+{
+template class MatrixAnimationFrameCache<RGBAColor>;
+template class MatrixAnimationFrameCache<AnalogAlpha>;
+
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DOF
+{
+
+template <typename MatrixElementType> class MatrixAnimationFrames
+{
+public:
+   MatrixAnimationFrames(int width, int height, int frameCount)
+      : m_width(width)
+      , m_height(height)
+      , m_frameCount(frameCount)
+      , m_elements(static_cast<size_t>(width) * height * frameCount)
+   {
+   }
+
+   int GetWidth() const { return m_width; }
+   int GetHeight() const { return m_height; }
+   int GetFrameCount() const { return m_frameCount; }
+   const MatrixElementType* GetRow(int frame, int y) const { return m_elements.data() + (static_cast<size_t>(frame) * m_height + y) * m_width; }
+   MatrixElementType* GetRow(int frame, int y) { return m_elements.data() + (static_cast<size_t>(frame) * m_height + y) * m_width; }
+
+private:
+   int m_width;
+   int m_height;
+   int m_frameCount;
+   std::vector<MatrixElementType> m_elements;
+};
+
+template <typename MatrixElementType> class MatrixAnimationFrameCache
+{
+public:
+   static MatrixAnimationFrameCache& GetInstance();
+
+   std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> Get(const std::string& key);
+   std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> Add(const std::string& key, std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> frames);
+
+private:
+   MatrixAnimationFrameCache() { }
+   MatrixAnimationFrameCache(const MatrixAnimationFrameCache&) = delete;
+   MatrixAnimationFrameCache& operator=(const MatrixAnimationFrameCache&) = delete;
+
+   std::unordered_map<std::string, std::weak_ptr<const MatrixAnimationFrames<MatrixElementType>>> m_frames;
+   std::mutex m_mutex;
+};
+
+template <typename MatrixElementType> MatrixAnimationFrameCache<MatrixElementType>& MatrixAnimationFrameCache<MatrixElementType>::GetInstance()
+{
+   static MatrixAnimationFrameCache instance;
+   return instance;
+}
+
+template <typename MatrixElementType> std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> MatrixAnimationFrameCache<MatrixElementType>::Get(const std::string& key)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+   auto it = m_frames.find(key);
+   if (it == m_frames.end())
+      return nullptr;
+   return it->second.lock();
+}
+
+template <typename MatrixElementType>
+std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> MatrixAnimationFrameCache<MatrixElementType>::Add(
+   const std::string& key, std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> frames)
+{
+   std::lock_guard<std::mutex> lock(m_mutex);
+
+   // The cache only holds weak references, frames are freed once the last effect using them is finished.
+   for (auto it = m_frames.begin(); it != m_frames.end();)
+   {
+      if (it->second.expired())
+         it = m_frames.erase(it);
+      else
+         ++it;
+   }
+
+   // Effects initialized in parallel may have converted the same frames, the first one added wins.
+   std::weak_ptr<const MatrixAnimationFrames<MatrixElementType>>& entry = m_frames[key];
+   if (auto existing = entry.lock())
+      return existing;
+
+   entry = frames;
+   return frames;
+}
+
+}
\ No newline at end of file
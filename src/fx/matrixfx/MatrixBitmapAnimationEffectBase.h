@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MatrixBitmapEffectBase.h"
+#include "MatrixAnimationFrameCache.h"
 #include "MatrixAnimationStepDirectionEnum.h"
 #include "AnimationBehaviourEnum.h"
 #include "../../general/StringExtensions.h"
@@ -8,7 +9,10 @@
 #include "../../pinballsupport/AlarmHandler.h"
 #include "../../pinballsupport/Action.h"
 #include "../../general/bitmap/PixelData.h"
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
+#include <memory>
 #include <vector>
 
 namespace DOF
@@ -43,13 +47,21 @@ public:
 protected:
    void ControlAnimation(int fadeValue);
    void Animate();
+   void AnimateFrame();
    void StopAnimation();
    void CleanupPixels();
+   void OutputFrame(int frame, int fadeValue);
+   int GetStepCount() const { return m_frames ? m_frames->GetFrameCount() : 0; }
+   virtual void InitBitmap(const std::string& filename) override;
+   virtual bool LoadBitmap(const FastImage& image, const std::string& filename) override;
+   virtual std::string GetFrameCacheKey(const std::string& filename) const;
+   std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> LoadFrames(const FastImage& image, const std::string& filename);
 
    bool m_animationActive;
    int m_animationStep;
    int m_animationFadeValue;
-   std::vector<PixelData**> m_pixels;
+   int m_animationElapsedMs;
+   std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> m_frames;
 
 private:
    int m_animationFrameCount;
@@ -65,6 +77,7 @@ MatrixBitmapAnimationEffectBase<MatrixElementType>::MatrixBitmapAnimationEffectB
    : m_animationActive(false)
    , m_animationStep(0)
    , m_animationFadeValue(0)
+   , m_animationElapsedMs(0)
    , m_animationFrameCount(1)
    , m_animationStepSize(1)
    , m_animationFrameDurationMs(30)
@@ -73,10 +86,17 @@ MatrixBitmapAnimationEffectBase<MatrixElementType>::MatrixBitmapAnimationEffectB
 {
 }
 
-template <typename MatrixElementType> MatrixBitmapAnimationEffectBase<MatrixElementType>::~MatrixBitmapAnimationEffectBase() { CleanupPixels(); }
+template <typename MatrixElementType> MatrixBitmapAnimationEffectBase<MatrixElementType>::~MatrixBitmapAnimationEffectBase()
+{
+   this->WaitForPendingInit();
+   CleanupPixels();
+}
 
 template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::Trigger(TableElementData* tableElementData)
 {
+   if (this->DeferTrigger(tableElementData))
+      return;
+
    if (this->m_initOK)
    {
       int fadeValue = tableElementData->m_value;
@@ -100,7 +120,8 @@ template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<Matri
          {
             m_animationStep = 0;
          }
-         this->m_table->GetPinball()->GetAlarms()->RegisterIntervalAlarm(m_animationFrameDurationMs, Action(this, &MatrixBitmapAnimationEffectBase<MatrixElementType>::Animate));
+         m_animationElapsedMs = 0;
+         this->m_table->GetPinball()->GetAlarms()->RegisterFrameAlarm(Action(this, &MatrixBitmapAnimationEffectBase<MatrixElementType>::AnimateFrame));
 
          Animate();
       }
@@ -117,7 +138,7 @@ template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<Matri
    {
       try
       {
-         this->m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(Action(this, &MatrixBitmapAnimationEffectBase<MatrixElementType>::Animate));
+         this->m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(Action(this, &MatrixBitmapAnimationEffectBase<MatrixElementType>::AnimateFrame));
       }
       catch (...)
       {
@@ -125,33 +146,21 @@ template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<Matri
 
       m_animationActive = false;
 
+      MatrixElementType value = this->GetEffectValue(0, PixelData());
       for (int y = this->m_areaTop; y <= this->m_areaBottom; y++)
-      {
-         for (int x = this->m_areaLeft; x <= this->m_areaRight; x++)
-         {
-            this->m_matrix->SetElement(this->GetLayerNr(), x, y, this->GetEffectValue(0, PixelData()));
-         }
-      }
+         this->m_matrix->FillRow(this->GetLayerNr(), this->m_areaLeft, y, this->GetAreaWidth(), value);
    }
 }
 
 template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::Animate()
 {
-   if (m_animationStep < static_cast<int>(m_pixels.size()))
+   if (m_animationStep < GetStepCount())
    {
-      for (int y = 0; y < this->GetAreaHeight(); y++)
-      {
-         int yd = y + this->m_areaTop;
-         for (int x = 0; x < this->GetAreaWidth(); x++)
-         {
-            int xd = x + this->m_areaLeft;
-            this->m_matrix->SetElement(this->GetLayerNr(), xd, yd, this->GetEffectValue(m_animationFadeValue, m_pixels[m_animationStep][x][y]));
-         }
-      }
+      OutputFrame(m_animationStep, m_animationFadeValue);
       m_animationStep++;
       if (m_animationBehaviour != AnimationBehaviourEnum::Once)
       {
-         m_animationStep = m_animationStep % static_cast<int>(m_pixels.size());
+         m_animationStep = m_animationStep % GetStepCount();
       }
    }
    else
@@ -164,9 +173,33 @@ template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<Matri
    }
 }
 
+template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::AnimateFrame()
+{
+   m_animationElapsedMs += this->m_table->GetPinball()->GetAlarms()->GetFrameIntervalMs();
+
+   int steps = m_animationElapsedMs / m_animationFrameDurationMs;
+   if (steps == 0)
+      return;
+
+   m_animationElapsedMs -= steps * m_animationFrameDurationMs;
+
+   // Frame durations shorter than the frame interval skip ahead instead of drawing the intermediate steps.
+   if (steps > 1 && GetStepCount() > 0)
+   {
+      m_animationStep += steps - 1;
+      if (m_animationBehaviour != AnimationBehaviourEnum::Once)
+         m_animationStep = m_animationStep % GetStepCount();
+      else
+         m_animationStep = std::min(m_animationStep, GetStepCount());
+   }
+
+   Animate();
+}
+
 template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::Init(Table* table)
 {
    this->m_initOK = false;
+   this->WaitForPendingInit();
    CleanupPixels();
    MatrixEffectBase<MatrixElementType>::Init(table);
 
@@ -175,88 +208,11 @@ template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<Matri
       FileInfo* fi = this->GetBitmapFilePattern()->GetFirstMatchingFile(table->GetPinball()->GetGlobalConfig()->GetReplaceValuesDictionary());
       if (fi != nullptr && fi->Exists())
       {
-         FastImage* bm = nullptr;
-         try
-         {
-            auto& bitmaps = table->GetBitmaps();
-            bm = &bitmaps[fi->FullName()];
-         }
-         catch (...)
-         {
-            Log::Exception(StringExtensions::Build("MatrixBitmapAnimationEffectBase {0} cant initialize.  Could not load file {1}.", this->GetName(), fi->FullName()));
-            delete fi;
-            return;
-         }
-
-         const auto& frames = bm->GetFrames();
-         auto frameIt = frames.find(this->GetBitmapFrameNumber());
-         if (frameIt != frames.end())
-         {
-            int stepCount = m_animationFrameCount;
-            switch (m_animationStepDirection)
-            {
-            case MatrixAnimationStepDirectionEnum::Frame:
-            {
-               if ((this->GetBitmapFrameNumber() + (stepCount * m_animationStepSize)) > static_cast<int>(frames.size()))
-               {
-                  stepCount = (static_cast<int>(frames.size()) - this->GetBitmapFrameNumber()) / m_animationStepSize;
-               }
-
-               m_pixels.resize(stepCount);
-               for (int s = 0; s < stepCount; s++)
-               {
-                  auto stepFrameIt = frames.find(this->GetBitmapFrameNumber() + s);
-                  if (stepFrameIt != frames.end())
-                  {
-                     FastBitmap clippedBitmap = stepFrameIt->second.GetClip(this->GetAreaWidth(), this->GetAreaHeight(), this->GetBitmapLeft(), this->GetBitmapTop(), this->GetBitmapWidth(),
-                        this->GetBitmapHeight(), this->GetDataExtractMode());
-                     m_pixels[s] = clippedBitmap.GetPixels();
-                  }
-               }
-               break;
-            }
-            case MatrixAnimationStepDirectionEnum::Right:
-            {
-               m_pixels.resize(stepCount);
-               for (int s = 0; s < stepCount; s++)
-               {
-                  FastBitmap clippedBitmap = frameIt->second.GetClip(this->GetAreaWidth(), this->GetAreaHeight(), this->GetBitmapLeft() + s * m_animationStepSize, this->GetBitmapTop(),
-                     this->GetBitmapWidth(), this->GetBitmapHeight(), this->GetDataExtractMode());
-                  m_pixels[s] = clippedBitmap.GetPixels();
-               }
-               break;
-            }
-            case MatrixAnimationStepDirectionEnum::Down:
-            {
-               m_pixels.resize(stepCount);
-               for (int s = 0; s < stepCount; s++)
-               {
-                  FastBitmap clippedBitmap = frameIt->second.GetClip(this->GetAreaWidth(), this->GetAreaHeight(), this->GetBitmapLeft(), this->GetBitmapTop() + s * m_animationStepSize,
-                     this->GetBitmapWidth(), this->GetBitmapHeight(), this->GetDataExtractMode());
-                  m_pixels[s] = clippedBitmap.GetPixels();
-               }
-               break;
-            }
-            default:
-            {
-               stepCount = 1;
-               m_pixels.resize(stepCount);
-               FastBitmap clippedBitmap = frameIt->second.GetClip(
-                  this->GetAreaWidth(), this->GetAreaHeight(), this->GetBitmapLeft(), this->GetBitmapTop(), this->GetBitmapWidth(), this->GetBitmapHeight(), this->GetDataExtractMode());
-               m_pixels[0] = clippedBitmap.GetPixels();
-               break;
-            }
-            }
-
-            std::vector<std::string> args = { std::to_string(this->GetAreaWidth()), std::to_string(this->GetAreaHeight()), std::to_string(this->GetBitmapLeft()),
-               std::to_string(this->GetBitmapTop()), std::to_string(this->GetBitmapWidth()), std::to_string(this->GetBitmapHeight()), std::to_string(stepCount) };
-            Log::Instrumentation("MX", StringExtensions::Build("BitmapAnimationEffectBase. Grabbed image clips: W: {0}, H:{1}, BML: {2}, BMT: {3}, BMW: {4}, BMH: {5}, Steps: {6}", args));
-         }
+         // Frames of images still being decoded in the background are converted on the loader threads as well, unless they are cached already.
+         if (table->GetBitmaps().IsLoading(fi->FullName()) && MatrixAnimationFrameCache<MatrixElementType>::GetInstance().Get(GetFrameCacheKey(fi->FullName())) == nullptr)
+            this->InitBitmapAsync(fi->FullName());
          else
-         {
-            Log::Warning(StringExtensions::Build("MatrixBitmapAnimationEffectBase {0} cant initialize. Frame {1} does not exist in source image {2}.", this->GetName(),
-               std::to_string(this->GetBitmapFrameNumber()), fi->FullName()));
-         }
+            InitBitmap(fi->FullName());
          delete fi;
       }
       else
@@ -271,29 +227,137 @@ template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<Matri
       Log::Warning(StringExtensions::Build("MatrixBitmapAnimationEffectBase {0} cant initialize. The BitmapFilePattern {1} is invalid", this->GetName(),
          this->GetBitmapFilePattern() ? this->GetBitmapFilePattern()->GetPattern() : "(null)"));
    }
+}
 
-   this->m_initOK = (!m_pixels.empty() && this->m_matrixLayer != nullptr);
+template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::InitBitmap(const std::string& filename)
+{
+   // Effects using the same clips of the same file share one converted copy of the frames, even across tables.
+   m_frames = MatrixAnimationFrameCache<MatrixElementType>::GetInstance().Get(GetFrameCacheKey(filename));
+   if (m_frames != nullptr)
+      this->m_initOK = (this->m_matrixLayer != nullptr);
+   else
+      MatrixBitmapEffectBase<MatrixElementType>::InitBitmap(filename);
 }
 
-template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::CleanupPixels()
+template <typename MatrixElementType> bool MatrixBitmapAnimationEffectBase<MatrixElementType>::LoadBitmap(const FastImage& image, const std::string& filename)
 {
-   for (auto pixels : m_pixels)
+   std::string cacheKey = GetFrameCacheKey(filename);
+   std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> frames = LoadFrames(image, filename);
+   if (frames != nullptr)
+      m_frames = MatrixAnimationFrameCache<MatrixElementType>::GetInstance().Add(cacheKey, frames);
+
+   return GetStepCount() > 0;
+}
+
+template <typename MatrixElementType>
+std::shared_ptr<const MatrixAnimationFrames<MatrixElementType>> MatrixBitmapAnimationEffectBase<MatrixElementType>::LoadFrames(const FastImage& image, const std::string& filename)
+{
+   const auto& frames = image.GetFrames();
+   auto frameIt = frames.find(this->GetBitmapFrameNumber());
+   if (frameIt == frames.end())
    {
-      if (pixels != nullptr)
+      Log::Warning(StringExtensions::Build("MatrixBitmapAnimationEffectBase {0} cant initialize. Frame {1} does not exist in source image {2}.", this->GetName(),
+         std::to_string(this->GetBitmapFrameNumber()), filename));
+      return nullptr;
+   }
+
+   int stepCount = m_animationFrameCount;
+   if (m_animationStepDirection == MatrixAnimationStepDirectionEnum::Frame)
+   {
+      if ((this->GetBitmapFrameNumber() + (stepCount * m_animationStepSize)) > static_cast<int>(frames.size()))
       {
-         for (int x = 0; x < this->GetAreaWidth(); x++)
-         {
-            delete[] pixels[x];
-         }
-         delete[] pixels;
+         stepCount = (static_cast<int>(frames.size()) - this->GetBitmapFrameNumber()) / m_animationStepSize;
       }
    }
-   m_pixels.clear();
+   else if (m_animationStepDirection != MatrixAnimationStepDirectionEnum::Right && m_animationStepDirection != MatrixAnimationStepDirectionEnum::Down)
+   {
+      stepCount = 1;
+   }
+   if (stepCount <= 0)
+      return nullptr;
+
+   int width = this->GetAreaWidth();
+   int height = this->GetAreaHeight();
+   auto result = std::make_shared<MatrixAnimationFrames<MatrixElementType>>(width, height, stepCount);
+   for (int s = 0; s < stepCount; s++)
+   {
+      const FastBitmap* source = &frameIt->second;
+      int left = this->GetBitmapLeft();
+      int top = this->GetBitmapTop();
+      switch (m_animationStepDirection)
+      {
+      case MatrixAnimationStepDirectionEnum::Frame:
+      {
+         auto stepFrameIt = frames.find(this->GetBitmapFrameNumber() + s);
+         source = (stepFrameIt != frames.end()) ? &stepFrameIt->second : nullptr;
+         break;
+      }
+      case MatrixAnimationStepDirectionEnum::Right: left += s * m_animationStepSize; break;
+      case MatrixAnimationStepDirectionEnum::Down: top += s * m_animationStepSize; break;
+      default: break;
+      }
+      if (source == nullptr)
+         continue;
+
+      // Frames are stored row by row in the layer format at full fade, so Animate can copy them straight into the layer.
+      FastBitmap clippedBitmap = source->GetClip(width, height, left, top, this->GetBitmapWidth(), this->GetBitmapHeight(), this->GetDataExtractMode());
+      if (!clippedBitmap.IsValid())
+         continue;
+      for (int y = 0; y < height; y++)
+      {
+         MatrixElementType* row = result->GetRow(s, y);
+         for (int x = 0; x < width; x++)
+            row[x] = this->GetEffectValue(255, clippedBitmap.GetPixel(x, y));
+      }
+   }
+
+   if (Log::IsInstrumentationEnabled("MX"))
+   {
+      std::vector<std::string> args = { std::to_string(width), std::to_string(height), std::to_string(this->GetBitmapLeft()), std::to_string(this->GetBitmapTop()),
+         std::to_string(this->GetBitmapWidth()), std::to_string(this->GetBitmapHeight()), std::to_string(stepCount) };
+      Log::Instrumentation("MX", StringExtensions::Build("BitmapAnimationEffectBase. Grabbed image clips: W: {0}, H:{1}, BML: {2}, BMT: {3}, BMW: {4}, BMH: {5}, Steps: {6}", args));
+   }
+   return result;
+}
+
+template <typename MatrixElementType> std::string MatrixBitmapAnimationEffectBase<MatrixElementType>::GetFrameCacheKey(const std::string& filename) const
+{
+   std::error_code ec;
+   auto lastWriteTime = std::filesystem::last_write_time(filename, ec).time_since_epoch().count();
+   std::vector<std::string> args = { this->GetXmlElementName(), filename, std::to_string(ec ? 0 : lastWriteTime), std::to_string(this->GetBitmapFrameNumber()),
+      std::to_string(static_cast<int>(m_animationStepDirection)), std::to_string(m_animationStepSize), std::to_string(m_animationFrameCount), std::to_string(this->GetBitmapLeft()),
+      std::to_string(this->GetBitmapTop()), std::to_string(this->GetBitmapWidth()), std::to_string(this->GetBitmapHeight()), std::to_string(static_cast<int>(this->GetDataExtractMode())),
+      std::to_string(this->GetAreaWidth()), std::to_string(this->GetAreaHeight()) };
+   std::string key;
+   for (const std::string& arg : args)
+      key.append(arg).append("|");
+   return key;
 }
 
+template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::OutputFrame(int frame, int fadeValue)
+{
+   int width = m_frames->GetWidth();
+   for (int y = 0; y < m_frames->GetHeight(); y++)
+   {
+      const MatrixElementType* row = m_frames->GetRow(frame, y);
+      if (fadeValue != 255)
+      {
+         // Only the alpha of the frame values depends on the fade value.
+         this->m_rowBuffer.assign(row, row + width);
+         for (MatrixElementType& value : this->m_rowBuffer)
+            value.SetAlpha((int)((float)value.GetAlpha() * fadeValue / 255));
+         row = this->m_rowBuffer.data();
+      }
+      this->m_matrix->WriteRow(this->GetLayerNr(), this->m_areaLeft, y + this->m_areaTop, row, width);
+   }
+}
+
+template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::CleanupPixels() { m_frames.reset(); }
+
 template <typename MatrixElementType> void MatrixBitmapAnimationEffectBase<MatrixElementType>::Finish()
 {
    StopAnimation();
+   this->WaitForPendingInit();
    CleanupPixels();
    MatrixEffectBase<MatrixElementType>::Finish();
 }
@@ -13,7 +13,13 @@
 #include "../../table/Table.h"
 #include "../../Pinball.h"
 #include "../../globalconfiguration/GlobalConfig.h"
+#include "../../general/bitmap/FastImageLoader.h"
+#include "../../pinballsupport/AlarmHandler.h"
+#include "../../pinballsupport/Action.h"
 #include "../../Log.h"
+#include <chrono>
+#include <future>
+#include <vector>
 
 namespace DOF
 {
@@ -48,8 +54,22 @@ public:
 
 protected:
    void OutputBitmap(int fadeValue);
+   void OutputPixels(PixelData** pixels, int fadeValue);
    void CleanupPixels();
+   virtual void InitBitmap(const std::string& filename);
+   virtual bool LoadBitmap(const FastImage& image, const std::string& filename);
+   void InitBitmapAsync(const std::string& filename);
+   void CompletePendingInit();
+   void WaitForPendingInit();
+   bool DeferTrigger(TableElementData* tableElementData);
+   void PollPendingInit();
+   void StopPendingInitPolling();
    PixelData** m_pixels;
+   std::vector<MatrixElementType> m_rowBuffer;
+   std::future<bool> m_pendingInit;
+   TableElementData m_deferredTrigger;
+   bool m_triggerDeferred;
+   bool m_pendingInitPolling;
 
 protected:
    bool m_initOK;
@@ -72,6 +92,8 @@ MatrixBitmapEffectBase<MatrixElementType>::MatrixBitmapEffectBase()
    : m_initOK(false)
    , m_bitmapFilePattern(nullptr)
    , m_pixels(nullptr)
+   , m_triggerDeferred(false)
+   , m_pendingInitPolling(false)
    , m_bitmapFrameNumber(0)
    , m_bitmapLeft(0)
    , m_bitmapTop(0)
@@ -81,12 +103,19 @@ MatrixBitmapEffectBase<MatrixElementType>::MatrixBitmapEffectBase()
 {
 }
 
-template <typename MatrixElementType> MatrixBitmapEffectBase<MatrixElementType>::~MatrixBitmapEffectBase() { CleanupPixels(); }
+template <typename MatrixElementType> MatrixBitmapEffectBase<MatrixElementType>::~MatrixBitmapEffectBase()
+{
+   WaitForPendingInit();
+   CleanupPixels();
+}
 
 template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::SetBitmapFilePattern(FilePattern* value) { m_bitmapFilePattern = value; }
 
 template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::Trigger(TableElementData* tableElementData)
 {
+   if (DeferTrigger(tableElementData))
+      return;
+
    if (m_initOK)
    {
       OutputBitmap(tableElementData->m_value);
@@ -96,6 +125,7 @@ template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementT
 template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::Init(Table* table)
 {
    m_initOK = false;
+   WaitForPendingInit();
    CleanupPixels();
    MatrixEffectBase<MatrixElementType>::Init(table);
 
@@ -104,34 +134,11 @@ template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementT
       FileInfo* fi = m_bitmapFilePattern->GetFirstMatchingFile(table->GetPinball()->GetGlobalConfig()->GetReplaceValuesDictionary());
       if (fi != nullptr && fi->Exists())
       {
-         FastImage* bm = nullptr;
-         try
-         {
-            auto& bitmaps = table->GetBitmaps();
-            bm = &bitmaps[fi->FullName()];
-         }
-         catch (...)
-         {
-            Log::Exception(StringExtensions::Build("MatrixBitmapEffectBase {0} cant initialize.  Could not load file {1}.", EffectBase::GetName(), fi->FullName()));
-            delete fi;
-            return;
-         }
-
-         const auto& frames = bm->GetFrames();
-         auto frameIt = frames.find(m_bitmapFrameNumber);
-         if (frameIt != frames.end())
-         {
-            std::vector<std::string> args = { std::to_string(this->GetAreaWidth()), std::to_string(this->GetAreaHeight()), std::to_string(m_bitmapLeft), std::to_string(m_bitmapTop),
-               std::to_string(m_bitmapWidth), std::to_string(m_bitmapHeight) };
-            Log::Instrumentation("MX", StringExtensions::Build("BitmapEffectBase. Grabbing image clip: W: {0}, H:{1}, BML: {2}, BMT: {3}, BMW: {4}, BMH: {5}", args));
-            FastBitmap clippedBitmap = frameIt->second.GetClip(this->GetAreaWidth(), this->GetAreaHeight(), m_bitmapLeft, m_bitmapTop, m_bitmapWidth, m_bitmapHeight, m_dataExtractMode);
-            m_pixels = clippedBitmap.GetPixels();
-         }
+         // Images still being decoded in the background are clipped on the loader threads as well, so table start does not wait for them.
+         if (table->GetBitmaps().IsLoading(fi->FullName()))
+            InitBitmapAsync(fi->FullName());
          else
-         {
-            Log::Warning(StringExtensions::Build(
-               "MatrixBitmapEffectBase {0} cant initialize. Frame {1} does not exist in source image {2}.", EffectBase::GetName(), std::to_string(m_bitmapFrameNumber), fi->FullName()));
-         }
+            InitBitmap(fi->FullName());
          delete fi;
       }
       else
@@ -146,8 +153,133 @@ template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementT
       Log::Warning(StringExtensions::Build(
          "MatrixBitmapEffectBase {0} cant initialize. The BitmapFilePattern {1} is invalid", EffectBase::GetName(), m_bitmapFilePattern ? m_bitmapFilePattern->GetPattern() : "(null)"));
    }
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::InitBitmap(const std::string& filename)
+{
+   FastImage* bm = nullptr;
+   try
+   {
+      auto& bitmaps = this->m_table->GetBitmaps();
+      bm = &bitmaps[filename];
+   }
+   catch (...)
+   {
+      Log::Exception(StringExtensions::Build("MatrixBitmapEffectBase {0} cant initialize.  Could not load file {1}.", EffectBase::GetName(), filename));
+      return;
+   }
+
+   m_initOK = (LoadBitmap(*bm, filename) && this->m_matrixLayer != nullptr);
+}
+
+template <typename MatrixElementType> bool MatrixBitmapEffectBase<MatrixElementType>::LoadBitmap(const FastImage& image, const std::string& filename)
+{
+   const auto& frames = image.GetFrames();
+   auto frameIt = frames.find(m_bitmapFrameNumber);
+   if (frameIt != frames.end())
+   {
+      if (Log::IsInstrumentationEnabled("MX"))
+      {
+         std::vector<std::string> args = { std::to_string(this->GetAreaWidth()), std::to_string(this->GetAreaHeight()), std::to_string(m_bitmapLeft), std::to_string(m_bitmapTop),
+            std::to_string(m_bitmapWidth), std::to_string(m_bitmapHeight) };
+         Log::Instrumentation("MX", StringExtensions::Build("BitmapEffectBase. Grabbing image clip: W: {0}, H:{1}, BML: {2}, BMT: {3}, BMW: {4}, BMH: {5}", args));
+      }
+      FastBitmap clippedBitmap = frameIt->second.GetClip(this->GetAreaWidth(), this->GetAreaHeight(), m_bitmapLeft, m_bitmapTop, m_bitmapWidth, m_bitmapHeight, m_dataExtractMode);
+      m_pixels = clippedBitmap.GetPixels();
+   }
+   else
+   {
+      Log::Warning(StringExtensions::Build(
+         "MatrixBitmapEffectBase {0} cant initialize. Frame {1} does not exist in source image {2}.", EffectBase::GetName(), std::to_string(m_bitmapFrameNumber), filename));
+   }
+
+   return m_pixels != nullptr;
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::InitBitmapAsync(const std::string& filename)
+{
+   // The loader task only touches the decoded image and this effect's own pixel data. Trigger leaves the effect alone until the task is done.
+   std::shared_future<FastImage*> image = this->m_table->GetBitmaps().GetPendingImage(filename);
+   m_pendingInit = FastImageLoader::GetInstance().Run(
+      [this, image, filename]()
+      {
+         FastImage* bm = nullptr;
+         try
+         {
+            bm = image.get();
+         }
+         catch (...)
+         {
+            Log::Exception(StringExtensions::Build("MatrixBitmapEffectBase {0} cant initialize.  Could not load file {1}.", EffectBase::GetName(), filename));
+            return false;
+         }
+         return LoadBitmap(*bm, filename);
+      });
+
+   m_triggerDeferred = false;
+   m_pendingInitPolling = true;
+   this->m_table->GetPinball()->GetAlarms()->RegisterFrameAlarm(Action(this, &MatrixBitmapEffectBase<MatrixElementType>::PollPendingInit));
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::CompletePendingInit()
+{
+   if (!m_pendingInit.valid() || m_pendingInit.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return;
+
+   m_initOK = (m_pendingInit.get() && this->m_matrixLayer != nullptr);
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::WaitForPendingInit()
+{
+   if (m_pendingInit.valid())
+   {
+      m_pendingInit.wait();
+      m_pendingInit = std::future<bool>();
+   }
+   StopPendingInitPolling();
+   m_triggerDeferred = false;
+}
+
+template <typename MatrixElementType> bool MatrixBitmapEffectBase<MatrixElementType>::DeferTrigger(TableElementData* tableElementData)
+{
+   CompletePendingInit();
+   if (!m_pendingInit.valid())
+      return false;
+
+   // Only the latest value matters. It is replayed by PollPendingInit once the bitmap is ready, so static effects triggered during startup still show up.
+   m_deferredTrigger = *tableElementData;
+   m_triggerDeferred = true;
+   return true;
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::PollPendingInit()
+{
+   CompletePendingInit();
+   if (m_pendingInit.valid())
+      return;
+
+   StopPendingInitPolling();
+   if (m_triggerDeferred)
+   {
+      m_triggerDeferred = false;
+      TableElementData tableElementData = m_deferredTrigger;
+      Trigger(&tableElementData);
+   }
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::StopPendingInitPolling()
+{
+   if (!m_pendingInitPolling)
+      return;
 
-   m_initOK = (m_pixels != nullptr && this->m_matrixLayer != nullptr);
+   m_pendingInitPolling = false;
+   try
+   {
+      this->m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(Action(this, &MatrixBitmapEffectBase<MatrixElementType>::PollPendingInit));
+   }
+   catch (...)
+   {
+   }
 }
 
 template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::CleanupPixels()
@@ -165,6 +297,7 @@ template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementT
 
 template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::Finish()
 {
+   WaitForPendingInit();
    CleanupPixels();
    MatrixEffectBase<MatrixElementType>::Finish();
 }
@@ -175,14 +308,18 @@ template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementT
    if (this->GetFadeMode() == FadeModeEnum::OnOff)
       fadeValue = (fadeValue < 1 ? 0 : 255);
 
+   OutputPixels(m_pixels, fadeValue);
+}
+
+template <typename MatrixElementType> void MatrixBitmapEffectBase<MatrixElementType>::OutputPixels(PixelData** pixels, int fadeValue)
+{
+   int width = this->GetAreaWidth();
+   m_rowBuffer.resize(width);
    for (int y = 0; y < this->GetAreaHeight(); y++)
    {
-      int yd = y + this->m_areaTop;
-      for (int x = 0; x < this->GetAreaWidth(); x++)
-      {
-         int xd = x + this->m_areaLeft;
-         this->m_matrix->SetElement(this->GetLayerNr(), xd, yd, GetEffectValue(fadeValue, m_pixels[x][y]));
-      }
+      for (int x = 0; x < width; x++)
+         m_rowBuffer[x] = GetEffectValue(fadeValue, pixels[x][y]);
+      this->m_matrix->WriteRow(this->GetLayerNr(), this->m_areaLeft, y + this->m_areaTop, m_rowBuffer.data(), width);
    }
 }
 
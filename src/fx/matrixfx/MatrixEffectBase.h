@@ -53,6 +53,11 @@ protected:
 
    int GetAreaWidth() const { return (m_areaRight - m_areaLeft) + 1; }
    int GetAreaHeight() const { return (m_areaBottom - m_areaTop) + 1; }
+   void MarkAreaDirty()
+   {
+      if (m_matrix != nullptr)
+         m_matrix->MarkDirty(m_areaLeft, m_areaTop, GetAreaWidth(), GetAreaHeight());
+   }
 
 private:
    std::string m_toyName;
@@ -122,16 +127,19 @@ template <typename MatrixElementType> void MatrixEffectBase<MatrixElementType>::
             m_areaTop = tmp;
          }
 
-         std::vector<std::string> args = { std::to_string(m_left), std::to_string(m_top), std::to_string(m_width), std::to_string(m_height), std::to_string(m_matrix->GetHeight()),
-            std::to_string(m_matrix->GetWidth()) };
-         std::vector<std::string> args2 = { std::to_string(m_areaLeft), std::to_string(m_areaTop), std::to_string(m_areaRight), std::to_string(m_areaBottom), std::to_string(GetAreaWidth()),
-            std::to_string(GetAreaHeight()) };
-         args.insert(args.end(), args2.begin(), args2.end());
-         args.push_back(this->GetXmlElementName());
-         Log::Instrumentation("MX",
-            StringExtensions::Build("MatrixBase for {12}. Calculated area size: AreaDef(L:{0}, T:{1}, W:{2}, H:{3}), Matrix(W:{4}, H:{5}), ResultArea(Left: {6}, Top:{7}, Right:{8}, "
-                                    "Bottom:{9}, Width:{10}, Height:{11})",
-               args));
+         if (Log::IsInstrumentationEnabled("MX"))
+         {
+            std::vector<std::string> args = { std::to_string(m_left), std::to_string(m_top), std::to_string(m_width), std::to_string(m_height), std::to_string(m_matrix->GetHeight()),
+               std::to_string(m_matrix->GetWidth()) };
+            std::vector<std::string> args2 = { std::to_string(m_areaLeft), std::to_string(m_areaTop), std::to_string(m_areaRight), std::to_string(m_areaBottom),
+               std::to_string(GetAreaWidth()), std::to_string(GetAreaHeight()) };
+            args.insert(args.end(), args2.begin(), args2.end());
+            args.push_back(this->GetXmlElementName());
+            Log::Instrumentation("MX",
+               StringExtensions::Build("MatrixBase for {12}. Calculated area size: AreaDef(L:{0}, T:{1}, W:{2}, H:{3}), Matrix(W:{4}, H:{5}), ResultArea(Left: {6}, Top:{7}, Right:{8}, "
+                                       "Bottom:{9}, Width:{10}, Height:{11})",
+                  args));
+         }
       }
    }
 
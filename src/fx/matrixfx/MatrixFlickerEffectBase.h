@@ -56,7 +56,7 @@ private:
    int m_currentValue;
    TableElementData* m_flickerTableElementData;
    std::mt19937 m_randomGenerator;
-   Action m_intervalAlarmCallback;
+   Action m_frameAlarmCallback;
 
    struct FlickerObject
    {
@@ -82,7 +82,7 @@ MatrixFlickerEffectBase<MatrixElementType>::MatrixFlickerEffectBase()
    , m_currentValue(0)
    , m_flickerTableElementData(nullptr)
    , m_randomGenerator(std::random_device { }())
-   , m_intervalAlarmCallback()
+   , m_frameAlarmCallback()
 {
 }
 
@@ -132,11 +132,11 @@ template <typename MatrixElementType> void MatrixFlickerEffectBase<MatrixElement
    {
       if (!m_active)
       {
-         if (!m_intervalAlarmCallback)
+         if (!m_frameAlarmCallback)
          {
-            m_intervalAlarmCallback = Action(this, &MatrixFlickerEffectBase<MatrixElementType>::DoFlicker);
+            m_frameAlarmCallback = Action(this, &MatrixFlickerEffectBase<MatrixElementType>::DoFlicker);
          }
-         this->m_table->GetPinball()->GetAlarms()->RegisterIntervalAlarm(30, m_intervalAlarmCallback);
+         this->m_table->GetPinball()->GetAlarms()->RegisterFrameAlarm(m_frameAlarmCallback);
          m_active = true;
       }
 
@@ -223,6 +223,7 @@ template <typename MatrixElementType> void MatrixFlickerEffectBase<MatrixElement
             this->m_matrixLayer[idx] = GetEffectValue(fv);
          }
       }
+      this->MarkAreaDirty();
    }
    else
    {
@@ -237,11 +238,12 @@ template <typename MatrixElementType> void MatrixFlickerEffectBase<MatrixElement
 
       m_inactiveFlickerObjects.insert(m_inactiveFlickerObjects.end(), m_activeFlickerObjects.begin(), m_activeFlickerObjects.end());
       m_activeFlickerObjects.clear();
+      this->MarkAreaDirty();
 
-      if (m_intervalAlarmCallback)
+      if (m_frameAlarmCallback)
       {
-         this->m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_intervalAlarmCallback);
-         m_intervalAlarmCallback = Action();
+         this->m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_frameAlarmCallback);
+         m_frameAlarmCallback = Action();
       }
       m_active = false;
    }
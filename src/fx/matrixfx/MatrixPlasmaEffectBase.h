@@ -96,14 +96,14 @@ template <typename MatrixElementType> void MatrixPlasmaEffectBase<MatrixElementT
       {
          if (!m_plasmaCallback)
             m_plasmaCallback = Action(this, &MatrixPlasmaEffectBase<MatrixElementType>::DoPlasma);
-         this->m_table->GetPinball()->GetAlarms()->RegisterIntervalAlarm(RefreshIntervalMs, m_plasmaCallback);
+         this->m_table->GetPinball()->GetAlarms()->RegisterFrameAlarm(m_plasmaCallback);
          m_active = true;
       }
       DrawFrame();
    }
    else
    {
-      this->m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_plasmaCallback);
+      this->m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_plasmaCallback);
       m_active = false;
       ClearFrame();
    }
@@ -113,7 +113,7 @@ template <typename MatrixElementType> void MatrixPlasmaEffectBase<MatrixElementT
 {
    int f = (this->GetFadeMode() == FadeModeEnum::OnOff ? (m_currentTriggerValue > 0 ? 255 : 0) : MathExtensions::Limit(m_currentTriggerValue, 0, 255));
 
-   m_time += ((double)m_plasmaSpeed / 2000);
+   m_time += ((double)m_plasmaSpeed / 2000) * ((double)this->m_table->GetPinball()->GetAlarms()->GetFrameIntervalMs() / RefreshIntervalMs);
    int w = this->GetAreaWidth();
    int h = this->GetAreaHeight();
 
@@ -148,6 +148,7 @@ template <typename MatrixElementType> void MatrixPlasmaEffectBase<MatrixElementT
          this->m_matrixLayer[idx] = GetEffectValue(f, m_time, v, xx, yy);
       }
    }
+   this->MarkAreaDirty();
 }
 
 template <typename MatrixElementType> void MatrixPlasmaEffectBase<MatrixElementType>::ClearFrame()
@@ -163,6 +164,7 @@ template <typename MatrixElementType> void MatrixPlasmaEffectBase<MatrixElementT
          this->m_matrixLayer[idx] = GetEffectValue(0, 0, 0, 0, 0);
       }
    }
+   this->MarkAreaDirty();
 }
 
 template <typename MatrixElementType> void MatrixPlasmaEffectBase<MatrixElementType>::PrecalcTimeValues(double time)
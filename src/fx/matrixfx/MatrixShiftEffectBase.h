@@ -41,8 +41,6 @@ private:
    void BuildStep2ElementTable();
    void DoStep();
 
-   static const int RefreshIntervalMs = 30;
-
    MatrixShiftDirectionEnum m_shiftDirection;
    float m_shiftSpeed;
    float m_shiftAcceleration;
@@ -77,14 +75,15 @@ template <typename MatrixElementType> void MatrixShiftEffectBase<MatrixElementTy
    float numberOfElements
       = (m_shiftDirection == MatrixShiftDirectionEnum::Left || m_shiftDirection == MatrixShiftDirectionEnum::Right) ? (float)this->GetAreaWidth() : (float)this->GetAreaHeight();
    float position = 0.0f;
-   float speed = numberOfElements / 100.0f * (m_shiftSpeed / (1000 / RefreshIntervalMs));
-   float acceleration = numberOfElements / 100.0f * (m_shiftAcceleration / (1000 / RefreshIntervalMs));
+   int refreshIntervalMs = this->m_table->GetPinball()->GetAlarms()->GetFrameIntervalMs();
+   float speed = numberOfElements / 100.0f * (m_shiftSpeed / (1000 / refreshIntervalMs));
+   float acceleration = numberOfElements / 100.0f * (m_shiftAcceleration / (1000 / refreshIntervalMs));
 
    while (position <= numberOfElements)
    {
       stepList.push_back(MathExtensions::Limit(position, 0.0f, numberOfElements));
       position += speed;
-      speed = MathExtensions::Limit(speed + acceleration, numberOfElements / 100.0f * (float)(1 / (1000 / RefreshIntervalMs)), 10000.0f);
+      speed = MathExtensions::Limit(speed + acceleration, numberOfElements / 100.0f * (float)(1 / (1000 / refreshIntervalMs)), 10000.0f);
    }
    stepList.push_back(MathExtensions::Limit(position, 0.0f, numberOfElements));
 
@@ -95,7 +94,7 @@ template <typename MatrixElementType> void MatrixShiftEffectBase<MatrixElementTy
 {
    if (!m_active)
    {
-      this->m_table->GetPinball()->GetAlarms()->RegisterIntervalAlarm(RefreshIntervalMs, m_stepCallback);
+      this->m_table->GetPinball()->GetAlarms()->RegisterFrameAlarm(m_stepCallback);
       m_active = true;
    }
 
@@ -205,6 +204,7 @@ template <typename MatrixElementType> void MatrixShiftEffectBase<MatrixElementTy
       }
       break;
    }
+   this->MarkAreaDirty();
 
    int dropKey = m_currentStep - ((int)m_step2Element.size() - 1);
    auto it = m_triggerValueBuffer.find(dropKey);
@@ -218,7 +218,7 @@ template <typename MatrixElementType> void MatrixShiftEffectBase<MatrixElementTy
       m_currentStep++;
    else
    {
-      this->m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_stepCallback);
+      this->m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_stepCallback);
       m_lastDiscardedValue = 0;
       m_currentStep = 0;
       m_active = false;
@@ -248,7 +248,7 @@ template <typename MatrixElementType> void MatrixShiftEffectBase<MatrixElementTy
 {
    try
    {
-      this->m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_stepCallback);
+      this->m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_stepCallback);
    }
    catch (...)
    {
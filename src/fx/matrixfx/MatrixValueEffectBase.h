@@ -29,13 +29,8 @@ template <typename MatrixElementType> void MatrixValueEffectBase<MatrixElementTy
 
       MatrixElementType d = GetEffectValue(v);
 
-      for (int x = this->m_areaLeft; x <= this->m_areaRight; x++)
-      {
-         for (int y = this->m_areaTop; y <= this->m_areaBottom; y++)
-         {
-            this->m_matrix->SetElement(this->GetLayerNr(), x, y, d);
-         }
-      }
+      for (int y = this->m_areaTop; y <= this->m_areaBottom; y++)
+         this->m_matrix->FillRow(this->GetLayerNr(), this->m_areaLeft, y, this->GetAreaWidth(), d);
    }
 }
 
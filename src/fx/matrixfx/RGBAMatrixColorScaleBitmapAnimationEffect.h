@@ -19,9 +19,8 @@ public:
 
    virtual std::string GetXmlElementName() const override { return "RGBAMatrixColorScaleBitmapAnimationEffect"; }
 
-   virtual void Init(Table* table) override;
-
 protected:
+   virtual std::string GetFrameCacheKey(const std::string& filename) const override;
    virtual RGBAColor GetEffectValue(int triggerValue, PixelData pixel) override;
 
 private:
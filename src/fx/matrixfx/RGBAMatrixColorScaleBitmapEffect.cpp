@@ -11,9 +11,12 @@ RGBAMatrixColorScaleBitmapEffect::RGBAMatrixColorScaleBitmapEffect()
 {
 }
 
-void RGBAMatrixColorScaleBitmapEffect::Init(Table* table)
+RGBAMatrixColorScaleBitmapEffect::~RGBAMatrixColorScaleBitmapEffect() { WaitForPendingInit(); }
+
+bool RGBAMatrixColorScaleBitmapEffect::LoadBitmap(const FastImage& image, const std::string& filename)
 {
-   MatrixBitmapEffectBase<RGBAColor>::Init(table);
+   if (!MatrixBitmapEffectBase<RGBAColor>::LoadBitmap(image, filename))
+      return false;
 
    if (this->m_pixels != nullptr)
    {
@@ -35,6 +38,8 @@ void RGBAMatrixColorScaleBitmapEffect::Init(Table* table)
          }
       }
    }
+
+   return true;
 }
 
 RGBAColor RGBAMatrixColorScaleBitmapEffect::GetEffectValue(int triggerValue, PixelData pixel)
@@ -10,7 +10,7 @@ class RGBAMatrixColorScaleBitmapEffect : public MatrixBitmapEffectBase<RGBAColor
 {
 public:
    RGBAMatrixColorScaleBitmapEffect();
-   virtual ~RGBAMatrixColorScaleBitmapEffect() = default;
+   virtual ~RGBAMatrixColorScaleBitmapEffect();
 
    const RGBAColor& GetActiveColor() const { return m_activeColor; }
    void SetActiveColor(const RGBAColor& value) { m_activeColor = value; }
@@ -19,9 +19,8 @@ public:
 
    virtual std::string GetXmlElementName() const override { return "RGBAMatrixColorScaleBitmapEffect"; }
 
-   virtual void Init(Table* table) override;
-
 protected:
+   virtual bool LoadBitmap(const FastImage& image, const std::string& filename) override;
    virtual RGBAColor GetEffectValue(int triggerValue, PixelData pixel) override;
 
 private:
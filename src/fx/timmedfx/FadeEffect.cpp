@@ -40,7 +40,8 @@ void FadeEffect::Trigger(TableElementData* tableElementData)
       {
          duration = duration / 255.0 * std::abs(m_targetValue - m_currentValue);
       }
-      int steps = (int)(duration > 0 ? (duration / FadingRefreshIntervalMs) : 0);
+      int fadingRefreshIntervalMs = m_table->GetPinball()->GetAlarms()->GetFrameIntervalMs();
+      int steps = (int)(duration > 0 ? (duration / fadingRefreshIntervalMs) : 0);
 
       if (steps > 0)
       {
@@ -50,7 +51,7 @@ void FadeEffect::Trigger(TableElementData* tableElementData)
       }
       else
       {
-         m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_fadingCallback);
+         m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_fadingCallback);
          m_currentValue = m_targetValue;
          m_lastTargetTriggerValue = -1;
          TriggerTargetEffect(&m_tableElementData);
@@ -64,11 +65,11 @@ void FadeEffect::FadingStep()
 
    if ((m_currentValue < m_targetValue && m_stepValue > 0) || (m_currentValue > m_targetValue && m_stepValue < 0))
    {
-      m_table->GetPinball()->GetAlarms()->RegisterIntervalAlarm(FadingRefreshIntervalMs, m_fadingCallback);
+      m_table->GetPinball()->GetAlarms()->RegisterFrameAlarm(m_fadingCallback);
    }
    else
    {
-      m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_fadingCallback);
+      m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_fadingCallback);
       m_currentValue = m_targetValue;
    }
 
@@ -84,7 +85,7 @@ void FadeEffect::Finish()
 {
    try
    {
-      m_table->GetPinball()->GetAlarms()->UnregisterIntervalAlarm(m_fadingCallback);
+      m_table->GetPinball()->GetAlarms()->UnregisterFrameAlarm(m_fadingCallback);
    }
    catch (...)
    {
@@ -28,7 +28,6 @@ public:
    virtual std::string GetXmlElementName() const override { return "FadeEffect"; }
 
 private:
-   static const int FadingRefreshIntervalMs = 30;
    void FadingStep();
 
    int m_fadeUpDuration;
@@ -0,0 +1,45 @@
+#include "TokenBucket.h"
+
+#include <algorithm>
+
+namespace DOF
+{
+
+TokenBucket::TokenBucket()
+   : m_interval(std::chrono::steady_clock::duration::zero())
+   , m_burstTolerance(std::chrono::steady_clock::duration::zero())
+   , m_nextTokenTime()
+{
+}
+
+void TokenBucket::Configure(std::chrono::steady_clock::duration interval, int burst)
+{
+   m_interval = std::max(interval, std::chrono::steady_clock::duration::zero());
+   m_burstTolerance = m_interval * (std::max(burst, 1) - 1);
+   Reset();
+}
+
+void TokenBucket::Reset() { m_nextTokenTime = std::chrono::steady_clock::time_point(); }
+
+bool TokenBucket::TryConsume(std::chrono::steady_clock::time_point now)
+{
+   if (!IsLimited())
+      return true;
+
+   // m_nextTokenTime is the time at which the bucket is full again. A token is available while that time is no more than a burst ahead of now.
+   std::chrono::steady_clock::time_point emptyTime = std::max(m_nextTokenTime, now);
+   if (emptyTime - now > m_burstTolerance)
+      return false;
+
+   m_nextTokenTime = emptyTime + m_interval;
+   return true;
+}
+
+std::chrono::steady_clock::time_point TokenBucket::GetNextTokenTime() const
+{
+   if (!IsLimited())
+      return std::chrono::steady_clock::time_point();
+   return m_nextTokenTime - m_burstTolerance;
+}
+
+}
\ No newline at end of file
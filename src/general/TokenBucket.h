@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+
+namespace DOF
+{
+
+class TokenBucket
+{
+public:
+   TokenBucket();
+
+   void Configure(std::chrono::steady_clock::duration interval, int burst = 1);
+   bool IsLimited() const { return m_interval.count() > 0; }
+   bool TryConsume(std::chrono::steady_clock::time_point now);
+   std::chrono::steady_clock::time_point GetNextTokenTime() const;
+   void Reset();
+
+private:
+   std::chrono::steady_clock::duration m_interval;
+   std::chrono::steady_clock::duration m_burstTolerance;
+   std::chrono::steady_clock::time_point m_nextTokenTime;
+};
+
+}
\ No newline at end of file
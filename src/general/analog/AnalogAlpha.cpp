@@ -10,8 +10,8 @@ AnalogAlpha::AnalogAlpha()
 }
 
 AnalogAlpha::AnalogAlpha(int value, int alpha)
-   : m_value(std::clamp(value, 0, 255))
-   , m_alpha(std::clamp(alpha, 0, 255))
+   : m_value(static_cast<uint8_t>(std::clamp(value, 0, 255)))
+   , m_alpha(static_cast<uint8_t>(std::clamp(alpha, 0, 255)))
 {
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 
 namespace DOF
 {
@@ -8,14 +9,14 @@ namespace DOF
 class AnalogAlpha
 {
 private:
-   int m_value;
-   int m_alpha;
+   uint8_t m_value;
+   uint8_t m_alpha;
 
 public:
    int GetValue() const { return m_value; }
-   void SetValue(int value) { m_value = std::clamp(value, 0, 255); }
+   void SetValue(int value) { m_value = static_cast<uint8_t>(std::clamp(value, 0, 255)); }
    int GetAlpha() const { return m_alpha; }
-   void SetAlpha(int value) { m_alpha = std::clamp(value, 0, 255); }
+   void SetAlpha(int value) { m_alpha = static_cast<uint8_t>(std::clamp(value, 0, 255)); }
    bool IsZero() const { return m_value == 0; }
    bool operator==(const AnalogAlpha& other) const;
    bool operator!=(const AnalogAlpha& other) const { return !(*this == other); }
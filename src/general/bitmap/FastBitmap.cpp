@@ -9,6 +9,13 @@
 #include <vector>
 #include <cstdio>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FASTBITMAP_CLIP_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FASTBITMAP_CLIP_NEON
+#endif
 
 namespace DOF
 {
@@ -184,140 +191,74 @@ FastBitmap FastBitmap::GetClip(int resultWidth, int resultHeight, int sourceLeft
    {
    case FastBitmapDataExtractModeEnum::BlendPixels:
    {
-      float red = 0.0f;
-      float green = 0.0f;
-      float blue = 0.0f;
-      float alpha = 0.0f;
-      float weight = 0.0f;
-
       float pixelSourceWidth = static_cast<float>(sourceWidth) / resultWidth;
       float pixelSourceHeight = static_cast<float>(sourceHeight) / resultHeight;
       float pixelSourceCount = pixelSourceWidth * pixelSourceHeight;
 
+      static_assert(sizeof(PixelData) == 4, "PixelData is expected to hold red, green, blue and alpha as consecutive bytes");
+      std::vector<int> columns;
+      std::vector<float> columnWeights;
+      std::vector<int> columnStarts;
+      std::vector<int> rows;
+      std::vector<float> rowWeights;
+      std::vector<int> rowStarts;
+      GetBlendWeights(sourceLeft, pixelSourceWidth, resultWidth, m_width, columns, columnWeights, columnStarts);
+      GetBlendWeights(sourceTop, pixelSourceHeight, resultHeight, m_height, rows, rowWeights, rowStarts);
+
+      // The source pixels of every result pixel are summed row by row with the weight of their row times the weight of their column.
+      // The terms and their order match the original per pixel loop exactly, so results stay bit identical. Only the four channels are summed in parallel.
+      const uint8_t* pixelData = reinterpret_cast<const uint8_t*>(m_pixels.data());
+      float sum[4];
       for (int y = 0; y < resultHeight; y++)
       {
-         float pixelSourceTop = sourceTop + y * pixelSourceHeight;
-         float pixelSourceBottom = pixelSourceTop + pixelSourceHeight;
-
          for (int x = 0; x < resultWidth; x++)
          {
-            int psr = 0;
-            int psb = 0;
-            float pixelSourceLeft = sourceLeft + x * pixelSourceWidth;
-            float pixelSourceRight = pixelSourceLeft + pixelSourceWidth;
-            red = 0.0f;
-            green = 0.0f;
-            blue = 0.0f;
-            alpha = 0.0f;
-
-            if (!MathExtensions::IsIntegral(pixelSourceTop))
+#if defined(FASTBITMAP_CLIP_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            __m128 acc = _mm_setzero_ps();
+            for (int r = rowStarts[y]; r < rowStarts[y + 1]; r++)
             {
-               if (!MathExtensions::IsIntegral(pixelSourceLeft))
-               {
-                  PixelData pd = GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceLeft)), static_cast<int>(MathExtensions::Floor(pixelSourceTop)));
-                  weight = (MathExtensions::Ceiling(pixelSourceTop) - pixelSourceTop) * (MathExtensions::Ceiling(pixelSourceLeft) - pixelSourceLeft);
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
-               }
-
-               psr = static_cast<int>(MathExtensions::Floor(pixelSourceRight));
-               weight = (MathExtensions::Ceiling(pixelSourceTop) - pixelSourceTop);
-               for (int xs = static_cast<int>(MathExtensions::Ceiling(pixelSourceLeft)); xs < psr; xs++)
+               const uint8_t* row = pixelData + rows[r] * m_width * 4;
+               for (int c = columnStarts[x]; c < columnStarts[x + 1]; c++)
                {
-                  PixelData pd = GetPixel(xs, static_cast<int>(MathExtensions::Floor(pixelSourceTop)));
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
-               }
-
-               if (!MathExtensions::IsIntegral(pixelSourceRight))
-               {
-                  weight = (MathExtensions::Ceiling(pixelSourceTop) - pixelSourceTop) * (pixelSourceRight - MathExtensions::Floor(pixelSourceRight));
-                  PixelData pd = GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceRight)), static_cast<int>(MathExtensions::Floor(pixelSourceTop)));
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
+                  int pixel;
+                  std::memcpy(&pixel, row + columns[c] * 4, 4);
+                  __m128i channels = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero);
+                  acc = _mm_add_ps(acc, _mm_mul_ps(_mm_cvtepi32_ps(channels), _mm_set1_ps(rowWeights[r] * columnWeights[c])));
                }
             }
-
-            psb = static_cast<int>(MathExtensions::Floor(pixelSourceBottom));
-            psr = static_cast<int>(MathExtensions::Floor(pixelSourceRight));
-            for (int ys = static_cast<int>(MathExtensions::Ceiling(pixelSourceTop)); ys < psb; ys++)
+            _mm_storeu_ps(sum, acc);
+#elif defined(FASTBITMAP_CLIP_NEON)
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            for (int r = rowStarts[y]; r < rowStarts[y + 1]; r++)
             {
-               if (!MathExtensions::IsIntegral(pixelSourceLeft))
+               const uint8_t* row = pixelData + rows[r] * m_width * 4;
+               for (int c = columnStarts[x]; c < columnStarts[x + 1]; c++)
                {
-                  PixelData pd = GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceLeft)), ys);
-                  weight = (MathExtensions::Ceiling(pixelSourceLeft) - pixelSourceLeft);
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
-               }
-
-               for (int xs = static_cast<int>(MathExtensions::Ceiling(pixelSourceLeft)); xs < psr; xs++)
-               {
-                  PixelData pd = GetPixel(xs, ys);
-                  red += pd.red;
-                  green += pd.green;
-                  blue += pd.blue;
-                  alpha += pd.alpha;
-               }
-
-               if (!MathExtensions::IsIntegral(pixelSourceRight))
-               {
-                  weight = (pixelSourceRight - psr);
-                  PixelData pd = GetPixel(psr, ys);
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
+                  uint16x4_t channels = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vld1_dup_u32(reinterpret_cast<const uint32_t*>(row + columns[c] * 4)))));
+                  acc = vaddq_f32(acc, vmulq_f32(vcvtq_f32_u32(vmovl_u16(channels)), vdupq_n_f32(rowWeights[r] * columnWeights[c])));
                }
             }
-
-            if (!MathExtensions::IsIntegral(pixelSourceBottom))
+            vst1q_f32(sum, acc);
+#else
+            sum[0] = sum[1] = sum[2] = sum[3] = 0.0f;
+            for (int r = rowStarts[y]; r < rowStarts[y + 1]; r++)
             {
-               psb = static_cast<int>(MathExtensions::Floor(pixelSourceBottom));
-               psr = static_cast<int>(MathExtensions::Floor(pixelSourceRight));
-
-               if (!MathExtensions::IsIntegral(pixelSourceLeft))
+               const uint8_t* row = pixelData + rows[r] * m_width * 4;
+               for (int c = columnStarts[x]; c < columnStarts[x + 1]; c++)
                {
-                  PixelData pd = GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceLeft)), psb);
-                  weight = (pixelSourceBottom - psb) * (MathExtensions::Ceiling(pixelSourceLeft) - pixelSourceLeft);
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
-               }
-
-               weight = (pixelSourceBottom - psb);
-               for (int xs = static_cast<int>(MathExtensions::Ceiling(pixelSourceLeft)); xs < psr; xs++)
-               {
-                  PixelData pd = GetPixel(xs, psb);
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
-               }
-
-               if (!MathExtensions::IsIntegral(pixelSourceRight))
-               {
-                  weight = (pixelSourceBottom - psb) * (pixelSourceRight - psr);
-                  PixelData pd = GetPixel(psr, psb);
-                  red += pd.red * weight;
-                  green += pd.green * weight;
-                  blue += pd.blue * weight;
-                  alpha += pd.alpha * weight;
+                  const uint8_t* pixel = row + columns[c] * 4;
+                  float weight = rowWeights[r] * columnWeights[c];
+                  sum[0] += pixel[0] * weight;
+                  sum[1] += pixel[1] * weight;
+                  sum[2] += pixel[2] * weight;
+                  sum[3] += pixel[3] * weight;
                }
             }
-
-            result.SetPixel(x, y,
-               PixelData(static_cast<uint8_t>(MathExtensions::Limit(red / pixelSourceCount, 0.0f, 255.0f)),
-                  static_cast<uint8_t>(MathExtensions::Limit(green / pixelSourceCount, 0.0f, 255.0f)), static_cast<uint8_t>(MathExtensions::Limit(blue / pixelSourceCount, 0.0f, 255.0f)),
-                  static_cast<uint8_t>(MathExtensions::Limit(alpha / pixelSourceCount, 0.0f, 255.0f))));
+#endif
+            result.m_pixels[y * resultWidth + x] = PixelData(static_cast<uint8_t>(MathExtensions::Limit(sum[0] / pixelSourceCount, 0.0f, 255.0f)),
+               static_cast<uint8_t>(MathExtensions::Limit(sum[1] / pixelSourceCount, 0.0f, 255.0f)), static_cast<uint8_t>(MathExtensions::Limit(sum[2] / pixelSourceCount, 0.0f, 255.0f)),
+               static_cast<uint8_t>(MathExtensions::Limit(sum[3] / pixelSourceCount, 0.0f, 255.0f)));
          }
       }
       break;
@@ -356,6 +297,39 @@ FastBitmap FastBitmap::GetClip(int resultWidth, int resultHeight, int sourceLeft
    return result;
 }
 
+void FastBitmap::GetBlendWeights(
+   int sourceStart, float pixelSourceSize, int resultSize, int sourceSize, std::vector<int>& indices, std::vector<float>& weights, std::vector<int>& starts)
+{
+   // Pixels outside of the bitmap are transparent black and add nothing to the sums, so they are left out.
+   auto addWeight = [&](int index, float weight)
+   {
+      if (index >= 0 && index < sourceSize)
+      {
+         indices.push_back(index);
+         weights.push_back(weight);
+      }
+   };
+
+   starts.assign(1, 0);
+   for (int i = 0; i < resultSize; i++)
+   {
+      float pixelSourceStart = sourceStart + i * pixelSourceSize;
+      float pixelSourceEnd = pixelSourceStart + pixelSourceSize;
+
+      if (!MathExtensions::IsIntegral(pixelSourceStart))
+         addWeight(static_cast<int>(MathExtensions::Floor(pixelSourceStart)), MathExtensions::Ceiling(pixelSourceStart) - pixelSourceStart);
+
+      int pse = static_cast<int>(MathExtensions::Floor(pixelSourceEnd));
+      for (int s = static_cast<int>(MathExtensions::Ceiling(pixelSourceStart)); s < pse; s++)
+         addWeight(s, 1.0f);
+
+      if (!MathExtensions::IsIntegral(pixelSourceEnd))
+         addWeight(pse, pixelSourceEnd - pse);
+
+      starts.push_back(static_cast<int>(indices.size()));
+   }
+}
+
 PixelData** FastBitmap::GetPixels() const
 {
    if (!IsValid())
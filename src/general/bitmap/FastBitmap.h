@@ -53,6 +53,8 @@ private:
    bool IsValidCoordinate(int x, int y) const;
    int GetPixelIndex(int x, int y) const;
    void SetFrameSize(int width, int height);
+   static void GetBlendWeights(
+      int sourceStart, float pixelSourceSize, int resultSize, int sourceSize, std::vector<int>& indices, std::vector<float>& weights, std::vector<int>& starts);
 };
 
 }
\ No newline at end of file
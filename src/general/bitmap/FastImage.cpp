@@ -4,6 +4,8 @@
 #include "../../Log.h"
 #include "../StringExtensions.h"
 
+#include <chrono>
+
 namespace DOF
 {
 
@@ -21,6 +23,7 @@ void FastImage::LoadImageFile(const std::string& imageFilePath)
 {
    m_frames.clear();
 
+   auto startTime = std::chrono::steady_clock::now();
    Image img = Image::FromFile(imageFilePath);
 
    int frameCount = img.GetFrameCount();
@@ -36,7 +39,8 @@ void FastImage::LoadImageFile(const std::string& imageFilePath)
 
    img.Dispose();
 
-   Log::Debug(StringExtensions::Build("FastImage::LoadImageFile: Loaded {0} frames from {1}", std::to_string(frameCount), imageFilePath));
+   auto durationMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+   Log::Write(StringExtensions::Build("Loaded {0} frames from image {1} in {2} ms", std::to_string(frameCount), imageFilePath, std::to_string(durationMs)));
 }
 
 void FastImage::AfterNameChange(const std::string& oldName, const std::string& newName) { LoadImageFile(newName); }
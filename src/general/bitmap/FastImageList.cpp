@@ -1,4 +1,5 @@
 #include "FastImageList.h"
+#include "FastImageLoader.h"
 #include "../../Log.h"
 #include "../StringExtensions.h"
 
@@ -10,7 +11,19 @@ FastImageList::FastImageList()
 {
 }
 
-FastImageList::~FastImageList() { }
+FastImageList::~FastImageList()
+{
+   for (auto& pendingImage : m_pendingImages)
+   {
+      try
+      {
+         delete pendingImage.second.get();
+      }
+      catch (...)
+      {
+      }
+   }
+}
 
 FastImage& FastImageList::operator[](const std::string& name)
 {
@@ -20,6 +33,24 @@ FastImage& FastImageList::operator[](const std::string& name)
       return *existing;
    }
 
+   // Images requested with LoadAsync are decoded on the loader threads, only wait for the one that is needed.
+   auto pendingImage = m_pendingImages.find(name);
+   if (pendingImage != m_pendingImages.end())
+   {
+      std::shared_future<FastImage*> image = std::move(pendingImage->second);
+      m_pendingImages.erase(pendingImage);
+      try
+      {
+         FastImage* f = image.get();
+         Add(f);
+         return *f;
+      }
+      catch (const std::exception& e)
+      {
+         throw std::runtime_error(StringExtensions::Build("Could not add file {0} to the FastImageList.", name));
+      }
+   }
+
    if (!m_dontAddIfMissing)
    {
       try
@@ -39,4 +70,24 @@ FastImage& FastImageList::operator[](const std::string& name)
    }
 }
 
+void FastImageList::LoadAsync(const std::string& name)
+{
+   if (m_dontAddIfMissing || Contains(name) || m_pendingImages.find(name) != m_pendingImages.end())
+      return;
+
+   m_pendingImages[name] = FastImageLoader::GetInstance().Load(name);
+}
+
+bool FastImageList::IsLoading(const std::string& name) const
+{
+   auto pendingImage = m_pendingImages.find(name);
+   return pendingImage != m_pendingImages.end() && pendingImage->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+std::shared_future<FastImage*> FastImageList::GetPendingImage(const std::string& name) const
+{
+   auto pendingImage = m_pendingImages.find(name);
+   return pendingImage != m_pendingImages.end() ? pendingImage->second : std::shared_future<FastImage*>();
+}
+
 }
\ No newline at end of file
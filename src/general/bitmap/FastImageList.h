@@ -3,6 +3,10 @@
 #include "../generic/NamedItemList.h"
 #include "FastImage.h"
 
+#include <future>
+#include <string>
+#include <unordered_map>
+
 namespace DOF
 {
 
@@ -13,12 +17,16 @@ public:
    virtual ~FastImageList();
 
    FastImage& operator[](const std::string& name);
+   void LoadAsync(const std::string& name);
+   bool IsLoading(const std::string& name) const;
+   std::shared_future<FastImage*> GetPendingImage(const std::string& name) const;
 
    bool GetDontAddIfMissing() const { return m_dontAddIfMissing; }
    void SetDontAddIfMissing(bool value) { m_dontAddIfMissing = value; }
 
 private:
    bool m_dontAddIfMissing;
+   std::unordered_map<std::string, std::shared_future<FastImage*>> m_pendingImages;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "FastImageLoader.h"
+#include "FastImage.h"
+
+#include <algorithm>
+
+namespace DOF
+{
+
+static const int MaxLoaderThreads = 4;
+
+FastImageLoader& FastImageLoader::GetInstance()
+{
+   static FastImageLoader instance;
+   return instance;
+}
+
+FastImageLoader::FastImageLoader()
+   : m_stopWorkers(false)
+{
+}
+
+FastImageLoader::~FastImageLoader()
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopWorkers = true;
+   }
+   m_taskCondition.notify_all();
+
+   for (std::thread& worker : m_workers)
+   {
+      if (worker.joinable())
+         worker.join();
+   }
+}
+
+std::future<FastImage*> FastImageLoader::Load(const std::string& filename)
+{
+   return Run([filename]() { return new FastImage(filename); });
+}
+
+void FastImageLoader::Post(std::function<void()> task)
+{
+   {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(std::move(task));
+
+      int maxWorkers = std::min(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())), MaxLoaderThreads);
+      if (static_cast<int>(m_workers.size()) < maxWorkers)
+         m_workers.emplace_back(&FastImageLoader::WorkerDoIt, this);
+   }
+   m_taskCondition.notify_one();
+}
+
+void FastImageLoader::WorkerDoIt()
+{
+   std::unique_lock<std::mutex> lock(m_mutex);
+   while (true)
+   {
+      m_taskCondition.wait(lock, [this] { return m_stopWorkers || !m_tasks.empty(); });
+      if (m_tasks.empty())
+         return;
+
+      std::function<void()> task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+   }
+}
+
+}
\ No newline at end of file
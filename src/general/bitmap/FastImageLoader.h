@@ -0,0 +1,54 @@
+#pragma once
+
+#include "DOF/DOF.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace DOF
+{
+
+class FastImage;
+
+class FastImageLoader
+{
+public:
+   static FastImageLoader& GetInstance();
+
+   ~FastImageLoader();
+
+   std::future<FastImage*> Load(const std::string& filename);
+   template <typename Function> std::future<typename std::invoke_result<Function>::type> Run(Function function);
+
+private:
+   FastImageLoader();
+   FastImageLoader(const FastImageLoader&) = delete;
+   FastImageLoader& operator=(const FastImageLoader&) = delete;
+
+   void Post(std::function<void()> task);
+   void WorkerDoIt();
+
+   std::deque<std::function<void()>> m_tasks;
+   std::vector<std::thread> m_workers;
+   std::mutex m_mutex;
+   std::condition_variable m_taskCondition;
+   bool m_stopWorkers;
+};
+
+template <typename Function> std::future<typename std::invoke_result<Function>::type> FastImageLoader::Run(Function function)
+{
+   auto task = std::make_shared<std::packaged_task<typename std::invoke_result<Function>::type()>>(std::move(function));
+   auto result = task->get_future();
+   Post([task]() { (*task)(); });
+   return result;
+}
+
+}
\ No newline at end of file
@@ -30,7 +30,7 @@ RGBAColor RGBAColor::Clone() const { return RGBAColor(GetHexColor()); }
 std::string RGBAColor::GetHexColor() const
 {
    std::ostringstream oss;
-   oss << "#" << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << m_red << std::setw(2) << m_green << std::setw(2) << m_blue << std::setw(2) << m_alpha;
+   oss << "#" << std::hex << std::uppercase << std::setfill('0') << std::setw(2) << GetRed() << std::setw(2) << GetGreen() << std::setw(2) << GetBlue() << std::setw(2) << GetAlpha();
    return oss.str();
 }
 
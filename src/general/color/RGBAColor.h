@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -9,23 +10,24 @@ namespace DOF
 
 class RGBColor;
 
+// Channels are stored as bytes, so layer buffers hold 4 bytes per led. The accessors keep working with ints.
 class RGBAColor
 {
 private:
-   int m_red;
-   int m_green;
-   int m_blue;
-   int m_alpha;
+   uint8_t m_red;
+   uint8_t m_green;
+   uint8_t m_blue;
+   uint8_t m_alpha;
 
 public:
    int GetRed() const { return m_red; }
-   void SetRed(int value) { m_red = std::clamp(value, 0, 255); }
+   void SetRed(int value) { m_red = static_cast<uint8_t>(std::clamp(value, 0, 255)); }
    int GetGreen() const { return m_green; }
-   void SetGreen(int value) { m_green = std::clamp(value, 0, 255); }
+   void SetGreen(int value) { m_green = static_cast<uint8_t>(std::clamp(value, 0, 255)); }
    int GetBlue() const { return m_blue; }
-   void SetBlue(int value) { m_blue = std::clamp(value, 0, 255); }
+   void SetBlue(int value) { m_blue = static_cast<uint8_t>(std::clamp(value, 0, 255)); }
    int GetAlpha() const { return m_alpha; }
-   void SetAlpha(int value) { m_alpha = std::clamp(value, 0, 255); }
+   void SetAlpha(int value) { m_alpha = static_cast<uint8_t>(std::clamp(value, 0, 255)); }
    RGBAColor Clone() const;
 
    std::string GetHexColor() const;
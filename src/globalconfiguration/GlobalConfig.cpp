@@ -32,6 +32,11 @@ GlobalConfig::GlobalConfig()
    , m_ledControlMinimumEffectDurationMs(60)
    , m_ledControlMinimumRGBEffectDurationMs(120)
    , m_pacLedDefaultMinCommandIntervalMs(10)
+   , m_effectFrameRate(33)
+   , m_inputCoalescing(false)
+   , m_lazyLedControlParsing(false)
+   , m_ledControlConfigCache(false)
+   , m_outputUpdateWorkerThreads(0)
    , m_enableLog(true)
    , m_clearLogOnSessionStart(true)
    , m_instrumentation("")
@@ -44,6 +49,10 @@ void GlobalConfig::SetLedWizDefaultMinCommandIntervalMs(int value) { m_ledWizDef
 
 void GlobalConfig::SetPacLedDefaultMinCommandIntervalMs(int value) { m_pacLedDefaultMinCommandIntervalMs = std::clamp(value, 0, 1000); }
 
+void GlobalConfig::SetEffectFrameRate(int value) { m_effectFrameRate = std::clamp(value, 1, 200); }
+
+void GlobalConfig::SetOutputUpdateWorkerThreads(int value) { m_outputUpdateWorkerThreads = std::clamp(value, 0, 16); }
+
 std::unordered_map<int, FileInfo> GlobalConfig::GetIniFilesDictionary(const std::string& tableFilename) const
 {
    std::vector<std::string> lookupPaths;
@@ -433,6 +442,26 @@ std::string GlobalConfig::ToXml() const
    element->SetText(m_pacLedDefaultMinCommandIntervalMs);
    doc.FirstChildElement("GlobalConfig")->InsertEndChild(element);
 
+   element = doc.NewElement("EffectFrameRate");
+   element->SetText(m_effectFrameRate);
+   doc.FirstChildElement("GlobalConfig")->InsertEndChild(element);
+
+   element = doc.NewElement("InputCoalescing");
+   element->SetText(m_inputCoalescing);
+   doc.FirstChildElement("GlobalConfig")->InsertEndChild(element);
+
+   element = doc.NewElement("LazyLedControlParsing");
+   element->SetText(m_lazyLedControlParsing);
+   doc.FirstChildElement("GlobalConfig")->InsertEndChild(element);
+
+   element = doc.NewElement("LedControlConfigCache");
+   element->SetText(m_ledControlConfigCache);
+   doc.FirstChildElement("GlobalConfig")->InsertEndChild(element);
+
+   element = doc.NewElement("OutputUpdateWorkerThreads");
+   element->SetText(m_outputUpdateWorkerThreads);
+   doc.FirstChildElement("GlobalConfig")->InsertEndChild(element);
+
    element = doc.NewElement("IniFilesPath");
    if (!m_iniFilesPath.empty())
       element->SetText(m_iniFilesPath.c_str());
@@ -528,6 +557,46 @@ GlobalConfig* GlobalConfig::FromXml(const std::string& configXml)
          globalConfig->SetPacLedDefaultMinCommandIntervalMs(value);
    }
 
+   element = root->FirstChildElement("EffectFrameRate");
+   if (element && element->GetText())
+   {
+      int value;
+      if (element->QueryIntText(&value) == tinyxml2::XML_SUCCESS)
+         globalConfig->SetEffectFrameRate(value);
+   }
+
+   element = root->FirstChildElement("InputCoalescing");
+   if (element && element->GetText())
+   {
+      bool value;
+      if (element->QueryBoolText(&value) == tinyxml2::XML_SUCCESS)
+         globalConfig->SetInputCoalescing(value);
+   }
+
+   element = root->FirstChildElement("LazyLedControlParsing");
+   if (element && element->GetText())
+   {
+      bool value;
+      if (element->QueryBoolText(&value) == tinyxml2::XML_SUCCESS)
+         globalConfig->SetLazyLedControlParsing(value);
+   }
+
+   element = root->FirstChildElement("LedControlConfigCache");
+   if (element && element->GetText())
+   {
+      bool value;
+      if (element->QueryBoolText(&value) == tinyxml2::XML_SUCCESS)
+         globalConfig->SetLedControlConfigCache(value);
+   }
+
+   element = root->FirstChildElement("OutputUpdateWorkerThreads");
+   if (element && element->GetText())
+   {
+      int value;
+      if (element->QueryIntText(&value) == tinyxml2::XML_SUCCESS)
+         globalConfig->SetOutputUpdateWorkerThreads(value);
+   }
+
    element = root->FirstChildElement("IniFilesPath");
    if (element && element->GetText())
       globalConfig->SetIniFilesPath(element->GetText());
@@ -26,6 +26,17 @@ public:
    void SetLedControlMinimumRGBEffectDurationMs(int value) { m_ledControlMinimumRGBEffectDurationMs = value; }
    int GetPacLedDefaultMinCommandIntervalMs() const { return m_pacLedDefaultMinCommandIntervalMs; }
    void SetPacLedDefaultMinCommandIntervalMs(int value);
+   int GetEffectFrameRate() const { return m_effectFrameRate; }
+   void SetEffectFrameRate(int value);
+   bool IsInputCoalescing() const { return m_inputCoalescing; }
+   void SetInputCoalescing(bool value) { m_inputCoalescing = value; }
+   bool IsLazyLedControlParsing() const { return m_lazyLedControlParsing; }
+   void SetLazyLedControlParsing(bool value) { m_lazyLedControlParsing = value; }
+   // The cache holds one entry per RomName, so enabling it also parses the LedControl files lazily for the current RomName.
+   bool IsLedControlConfigCache() const { return m_ledControlConfigCache; }
+   void SetLedControlConfigCache(bool value) { m_ledControlConfigCache = value; }
+   int GetOutputUpdateWorkerThreads() const { return m_outputUpdateWorkerThreads; }
+   void SetOutputUpdateWorkerThreads(int value);
    const std::string& GetIniFilesPath() const { return m_iniFilesPath; }
    void SetIniFilesPath(const std::string& path) { m_iniFilesPath = path; }
    std::unordered_map<int, FileInfo> GetIniFilesDictionary(const std::string& tableFilename = "") const;
@@ -68,6 +79,11 @@ private:
    int m_ledControlMinimumEffectDurationMs;
    int m_ledControlMinimumRGBEffectDurationMs;
    int m_pacLedDefaultMinCommandIntervalMs;
+   int m_effectFrameRate;
+   bool m_inputCoalescing;
+   bool m_lazyLedControlParsing;
+   bool m_ledControlConfigCache;
+   int m_outputUpdateWorkerThreads;
    std::string m_iniFilesPath;
    FilePattern m_shapeDefinitionFilePattern;
    FilePattern m_cabinetConfigFilePattern;
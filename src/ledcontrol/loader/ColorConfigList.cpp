@@ -14,22 +14,22 @@ ColorConfigList::~ColorConfigList()
       delete config;
 
    m_configs.clear();
+   m_nameIndex.clear();
 }
 
 void ColorConfigList::Add(ColorConfig* config)
 {
    if (config != nullptr)
+   {
       m_configs.push_back(config);
+      m_nameIndex.emplace(StringExtensions::ToLower(config->GetName()), config);
+   }
 }
 
-ColorConfig* ColorConfigList::FindByName(const std::string& name)
+ColorConfig* ColorConfigList::FindByName(const std::string& name) const
 {
-   for (ColorConfig* cc : m_configs)
-   {
-      if (StringExtensions::ToLower(cc->GetName()) == StringExtensions::ToLower(name))
-         return cc;
-   }
-   return nullptr;
+   auto it = m_nameIndex.find(StringExtensions::ToLower(name));
+   return it != m_nameIndex.end() ? it->second : nullptr;
 }
 
 ColorList ColorConfigList::GetCabinetColorList() const
@@ -76,14 +76,6 @@ void ColorConfigList::ParseLedControlData(const std::string& ledControlData, boo
    }
 }
 
-bool ColorConfigList::Contains(const std::string& colorName) const
-{
-   for (const ColorConfig* cc : m_configs)
-   {
-      if (StringExtensions::ToLower(cc->GetName()) == StringExtensions::ToLower(colorName))
-         return true;
-   }
-   return false;
-}
+bool ColorConfigList::Contains(const std::string& colorName) const { return FindByName(colorName) != nullptr; }
 
 }
\ No newline at end of file
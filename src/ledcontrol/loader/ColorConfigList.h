@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "DOF/DOF.h"
 #include "ColorConfig.h"
@@ -20,7 +21,7 @@ public:
    size_t Size() const { return m_configs.size(); }
    ColorConfig* operator[](size_t index) { return m_configs[index]; }
    const ColorConfig* operator[](size_t index) const { return m_configs[index]; }
-   ColorConfig* FindByName(const std::string& name);
+   ColorConfig* FindByName(const std::string& name) const;
    bool Contains(const std::string& name) const;
    void ParseLedControlData(const std::vector<std::string>& ledControlData, bool throwExceptions = false);
    void ParseLedControlData(const std::string& ledControlData, bool throwExceptions = false);
@@ -33,6 +34,7 @@ public:
 
 private:
    std::vector<ColorConfig*> m_configs;
+   std::unordered_map<std::string, ColorConfig*> m_nameIndex;
 };
 
 }
\ No newline at end of file
@@ -4,8 +4,7 @@
 #include "TableConfigColumnList.h"
 #include "TableConfigSetting.h"
 #include "ColorConfig.h"
-#include "TableVariablesDictionary.h"
-#include "VariablesDictionary.h"
+#include "LedControlVariableResolver.h"
 #include "../../Log.h"
 #include "../../general/FileReader.h"
 #include "../../general/StringExtensions.h"
@@ -13,6 +12,8 @@
 #include <algorithm>
 #include <stdexcept>
 #include <unordered_map>
+#include <unordered_set>
+#include <cctype>
 
 namespace DOF
 {
@@ -32,6 +33,15 @@ LedControlConfig::LedControlConfig(const std::string& ledControlIniFilename, int
    ParseLedControlIni(ledControlIniFilename, throwExceptions);
 }
 
+LedControlConfig::LedControlConfig(const std::string& ledControlIniFilename, int ledWizNumber, const std::string& romNameFilter, bool throwExceptions)
+   : m_ledWizNumber(ledWizNumber)
+   , m_tableConfigurations(new TableConfigList())
+   , m_colorConfigurations(new ColorConfigList())
+   , m_romNameFilter(romNameFilter)
+{
+   ParseLedControlIni(ledControlIniFilename, throwExceptions);
+}
+
 LedControlConfig::~LedControlConfig()
 {
    delete m_tableConfigurations;
@@ -72,14 +82,29 @@ void LedControlConfig::ParseLedControlIni(const std::string& ledControlIniFilena
    std::vector<std::string> sectionData;
    std::string sectionHeader;
 
-   std::vector<std::string> lines = StringExtensions::Split(fileData, { '\r', '\n' });
+   bool filterSection = false;
+   int skippedRowCount = 0;
 
-   for (const std::string& rawIniLine : lines)
+   size_t lineStart = 0;
+   while (lineStart < fileData.length())
    {
-      std::string iniLine = StringExtensions::Trim(rawIniLine);
-      if (iniLine.length() > 0 && !StringExtensions::StartsWith(iniLine, "#"))
+      size_t lineEnd = fileData.find_first_of("\r\n", lineStart);
+      if (lineEnd == std::string::npos)
+         lineEnd = fileData.length();
+
+      size_t start = lineStart;
+      size_t end = lineEnd;
+      lineStart = lineEnd + 1;
+
+      while (start < end && std::isspace(static_cast<unsigned char>(fileData[start])))
+         start++;
+      while (end > start && std::isspace(static_cast<unsigned char>(fileData[end - 1])))
+         end--;
+
+      std::string_view iniLine(fileData.data() + start, end - start);
+      if (iniLine.length() > 0 && iniLine[0] != '#')
       {
-         if (StringExtensions::StartsWith(iniLine, "[") && StringExtensions::EndsWith(iniLine, "]") && iniLine.length() > 2)
+         if (iniLine[0] == '[' && iniLine.back() == ']' && iniLine.length() > 2)
          {
             if (!StringExtensions::IsNullOrWhiteSpace(sectionHeader))
             {
@@ -100,10 +125,18 @@ void LedControlConfig::ParseLedControlIni(const std::string& ledControlIniFilena
                sectionData.clear();
             }
             sectionHeader = iniLine;
+
+            filterSection = !m_romNameFilter.empty()
+               && (std::find(outStartStrings.begin(), outStartStrings.end(), sectionHeader) != outStartStrings.end()
+                  || std::find(tableVariableStartStrings.begin(), tableVariableStartStrings.end(), sectionHeader) != tableVariableStartStrings.end());
+         }
+         else if (filterSection && !IsRomNameCandidate(m_romNameFilter, iniLine))
+         {
+            skippedRowCount++;
          }
          else
          {
-            sectionData.push_back(iniLine);
+            sectionData.emplace_back(iniLine);
          }
       }
    }
@@ -180,6 +213,12 @@ void LedControlConfig::ParseLedControlIni(const std::string& ledControlIniFilena
       return;
    }
 
+   if (outData.empty() && skippedRowCount > 0)
+   {
+      m_ledControlIniFile = ledControlIniFilename;
+      return;
+   }
+
    if (outData.empty())
    {
       Log::Warning(StringExtensions::Build("File {0} does not contain data in the table config section.", ledControlIniFilename));
@@ -190,85 +229,111 @@ void LedControlConfig::ParseLedControlIni(const std::string& ledControlIniFilena
 
    if (!tableVariableData.empty())
    {
-      Log::Write("Resolving Table Variables");
-      ResolveTableVariables(outData, tableVariableData);
+      Log::Write(StringExtensions::Build("Resolving Table Variables in {0}", ledControlIniFilename));
+      LedControlVariableResolver::ResolveTableVariables(outData, tableVariableData);
    }
 
    if (!variableData.empty())
    {
-      Log::Write("Resolving Global Variables");
-      ResolveVariables(outData, variableData);
+      Log::Write(StringExtensions::Build("Resolving Global Variables in {0}", ledControlIniFilename));
+      LedControlVariableResolver::ResolveVariables(outData, variableData);
+   }
+
+   if (m_romNameFilter.empty())
+   {
+      m_colorConfigurations->ParseLedControlData(colorData, throwExceptions);
+
+      m_tableConfigurations->ParseLedcontrolData(outData, throwExceptions);
    }
+   else
+   {
+      m_tableConfigurations->ParseLedcontrolData(outData, throwExceptions);
 
-   m_colorConfigurations->ParseLedControlData(colorData, throwExceptions);
+      m_resolvedColorData = GetReferencedColors(colorData);
+      m_resolvedTableData = std::move(outData);
+      m_colorConfigurations->ParseLedControlData(m_resolvedColorData, throwExceptions);
 
-   m_tableConfigurations->ParseLedcontrolData(outData, throwExceptions);
+      Log::Write(StringExtensions::Build("Parsed {0} of {1} table config rows for RomName {2} in {3}", std::to_string(m_tableConfigurations->Size()),
+         std::to_string(m_tableConfigurations->Size() + skippedRowCount), m_romNameFilter, ledControlIniFilename));
+   }
 
    ResolveRGBColors();
 
    m_ledControlIniFile = ledControlIniFilename;
 }
 
-std::vector<std::string> LedControlConfig::GetSection(const std::unordered_map<std::string, std::vector<std::string>>& sections, const std::vector<std::string>& sectionStartStrings)
+void LedControlConfig::LoadResolvedData(const std::string& ledControlIniFilename, const std::vector<std::string>& colorData, const std::vector<std::string>& tableData, bool throwExceptions)
 {
-   for (const std::string& startString : sectionStartStrings)
+   m_resolvedColorData = colorData;
+   m_resolvedTableData = tableData;
+
+   m_colorConfigurations->ParseLedControlData(m_resolvedColorData, throwExceptions);
+
+   m_tableConfigurations->ParseLedcontrolData(m_resolvedTableData, throwExceptions);
+
+   ResolveRGBColors();
+
+   m_ledControlIniFile = ledControlIniFilename;
+}
+
+bool LedControlConfig::IsRomNameCandidate(const std::string& romName, std::string_view iniLine)
+{
+   size_t tp = iniLine.find(',');
+   if (tp == std::string_view::npos)
+      return true;
+
+   std::string_view key = iniLine.substr(0, tp);
+   while (!key.empty() && std::isspace(static_cast<unsigned char>(key.back())))
+      key.remove_suffix(1);
+
+   // Rows using variables in the rom name column can only be matched after the variables have been resolved.
+   if (key.find('@') != std::string_view::npos)
+      return true;
+
+   if (key.length() > romName.length())
+      return false;
+
+   for (size_t i = 0; i < key.length(); i++)
    {
-      auto it = sections.find(startString);
-      if (it != sections.end())
-         return it->second;
+      if (std::toupper(static_cast<unsigned char>(key[i])) != std::toupper(static_cast<unsigned char>(romName[i])))
+         return false;
    }
-   return std::vector<std::string>();
+   return true;
 }
 
-void LedControlConfig::ResolveTableVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData)
+std::vector<std::string> LedControlConfig::GetReferencedColors(const std::vector<std::string>& colorData) const
 {
-   TableVariablesDictionary vd(variableData);
-
-   for (size_t i = 0; i < dataToResolve.size(); i++)
+   std::unordered_set<std::string> colorNames;
+   for (size_t i = 0; i < m_tableConfigurations->Size(); i++)
    {
-      std::string d = StringExtensions::Trim(dataToResolve[i]);
-      bool updated = false;
-      if (!StringExtensions::IsNullOrWhiteSpace(d))
+      for (TableConfigColumn* c : *(*m_tableConfigurations)[i]->GetColumns())
       {
-         size_t tp = d.find(",");
-         if (tp != std::string::npos && tp > 0)
+         for (TableConfigSetting* s : *c)
          {
-            std::string tableName = StringExtensions::Trim(d.substr(0, tp));
-            if (vd.find(tableName) != vd.end())
-            {
-               for (const auto& kv : vd[tableName])
-               {
-                  std::string n = kv.first;
-                  if (!StringExtensions::StartsWith(n, "@"))
-                     n = "@" + n;
-                  if (!StringExtensions::EndsWith(n, "@"))
-                     n += "@";
-                  d = StringExtensions::Replace(d, n, kv.second);
-                  updated = true;
-               }
-            }
+            if (!s->GetColorName().empty())
+               colorNames.insert(StringExtensions::ToLower(s->GetColorName()));
          }
       }
-      if (updated)
-         dataToResolve[i] = d;
    }
+
+   std::vector<std::string> referencedColors;
+   for (const std::string& d : colorData)
+   {
+      if (colorNames.find(StringExtensions::ToLower(d.substr(0, d.find('=')))) != colorNames.end())
+         referencedColors.push_back(d);
+   }
+   return referencedColors;
 }
 
-void LedControlConfig::ResolveVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData)
+std::vector<std::string> LedControlConfig::GetSection(const std::unordered_map<std::string, std::vector<std::string>>& sections, const std::vector<std::string>& sectionStartStrings)
 {
-   VariablesDictionary vd(variableData);
-
-   for (const auto& kv : vd)
+   for (const std::string& startString : sectionStartStrings)
    {
-      std::string n = kv.first;
-      if (!StringExtensions::StartsWith(n, "@"))
-         n = "@" + n;
-      if (!StringExtensions::EndsWith(n, "@"))
-         n += "@";
-
-      for (size_t i = 0; i < dataToResolve.size(); i++)
-         dataToResolve[i] = StringExtensions::Replace(dataToResolve[i], n, kv.second);
+      auto it = sections.find(startString);
+      if (it != sections.end())
+         return it->second;
    }
+   return std::vector<std::string>();
 }
 
 void LedControlConfig::ResolveRGBColors()
@@ -280,15 +345,12 @@ void LedControlConfig::ResolveRGBColors()
       {
          for (TableConfigSetting* s : *c)
          {
-            for (size_t j = 0; j < m_colorConfigurations->Size(); j++)
-            {
-               ColorConfig* cc = (*m_colorConfigurations)[j];
-               if (StringExtensions::ToLower(cc->GetName()) == StringExtensions::ToLower(s->GetColorName()))
-               {
-                  s->SetColorConfig(cc);
-                  break;
-               }
-            }
+            if (s->GetColorName().empty())
+               continue;
+
+            ColorConfig* cc = m_colorConfigurations->FindByName(s->GetColorName());
+            if (cc != nullptr)
+               s->SetColorConfig(cc);
          }
       }
    }
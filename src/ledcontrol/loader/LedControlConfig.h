@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "DOF/DOF.h"
@@ -19,6 +20,7 @@ class LedControlConfig
 public:
    LedControlConfig();
    LedControlConfig(const std::string& ledControlIniFilename, int ledWizNumber, bool throwExceptions = false);
+   LedControlConfig(const std::string& ledControlIniFilename, int ledWizNumber, const std::string& romNameFilter, bool throwExceptions = false);
    ~LedControlConfig();
 
    int GetLedWizNumber() const { return m_ledWizNumber; }
@@ -31,12 +33,16 @@ public:
    ColorConfigList* GetColorConfigurations() const { return m_colorConfigurations; }
    void SetColorConfigurations(ColorConfigList* configs) { m_colorConfigurations = configs; }
    const std::string& GetLedControlIniFile() const { return m_ledControlIniFile; }
+   const std::string& GetRomNameFilter() const { return m_romNameFilter; }
+   const std::vector<std::string>& GetResolvedColorData() const { return m_resolvedColorData; }
+   const std::vector<std::string>& GetResolvedTableData() const { return m_resolvedTableData; }
+   void LoadResolvedData(const std::string& ledControlIniFilename, const std::vector<std::string>& colorData, const std::vector<std::string>& tableData, bool throwExceptions = false);
 
 private:
    void ParseLedControlIni(const std::string& ledControlIniFilename, bool throwExceptions = false);
+   static bool IsRomNameCandidate(const std::string& romName, std::string_view iniLine);
+   std::vector<std::string> GetReferencedColors(const std::vector<std::string>& colorData) const;
    std::vector<std::string> GetSection(const std::unordered_map<std::string, std::vector<std::string>>& sections, const std::vector<std::string>& sectionStartStrings);
-   void ResolveTableVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData);
-   void ResolveVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData);
    void ResolveRGBColors();
 
    int m_ledWizNumber;
@@ -44,6 +50,9 @@ private:
    TableConfigList* m_tableConfigurations;
    ColorConfigList* m_colorConfigurations;
    std::string m_ledControlIniFile;
+   std::string m_romNameFilter;
+   std::vector<std::string> m_resolvedColorData;
+   std::vector<std::string> m_resolvedTableData;
 };
 
 }
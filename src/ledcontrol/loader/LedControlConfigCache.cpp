@@ -0,0 +1,277 @@
+#include "LedControlConfigCache.h"
+#include "LedControlConfig.h"
+#include "../../Log.h"
+#include "../../general/FileReader.h"
+#include "../../general/StringExtensions.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace DOF
+{
+
+static const uint32_t CacheFileMagic = 0x43464F44;
+static const uint32_t CacheFileVersion = 1;
+
+LedControlConfigCache::LedControlConfigCache(const std::string& cacheDirectory)
+   : m_cacheDirectory(cacheDirectory)
+   , m_cacheHit(false)
+{
+}
+
+LedControlConfigCache::~LedControlConfigCache() { }
+
+std::string LedControlConfigCache::GetCacheFilename(const std::string& ledControlIniFilename) const
+{
+   return (std::filesystem::path(m_cacheDirectory) / (std::filesystem::path(ledControlIniFilename).filename().string() + ".cache")).string();
+}
+
+LedControlConfig* LedControlConfigCache::Load(const std::string& ledControlIniFilename, int ledWizNumber, const std::string& romName, bool throwExceptions)
+{
+   m_cacheHit = false;
+
+   std::error_code ec;
+   uint64_t fileSize = std::filesystem::file_size(ledControlIniFilename, ec);
+   int64_t lastWriteTime = ec ? 0 : static_cast<int64_t>(std::filesystem::last_write_time(ledControlIniFilename, ec).time_since_epoch().count());
+   if (ec)
+      return new LedControlConfig(ledControlIniFilename, ledWizNumber, romName, throwExceptions);
+
+   std::string cacheFilename = GetCacheFilename(ledControlIniFilename);
+   std::string cacheData;
+   if (std::filesystem::exists(cacheFilename, ec))
+   {
+      try
+      {
+         cacheData = FileReader::ReadFileToString(cacheFilename);
+      }
+      catch (const std::exception&)
+      {
+         Log::Warning(StringExtensions::Build("Could not read LedControl cache file {0}.", cacheFilename));
+      }
+   }
+
+   CacheReader reader(cacheData);
+   CacheHeader header;
+   bool cacheValid = !cacheData.empty() && ReadHeader(reader, header) && header.sourceFilename == ledControlIniFilename && header.fileSize == fileSize;
+
+   if (cacheValid && header.lastWriteTime == lastWriteTime)
+   {
+      for (uint32_t i = 0; i < header.entryCount && reader.IsOk(); i++)
+      {
+         std::string_view entryRomName = reader.ReadString();
+         std::string_view entryData = reader.ReadString();
+         if (reader.IsOk() && entryRomName == romName)
+         {
+            CacheEntry entry;
+            if (!ReadEntryData(entryData, entry))
+               break;
+
+            LedControlConfig* lcc = new LedControlConfig();
+            lcc->SetLedWizNumber(ledWizNumber);
+            lcc->SetMinDOFVersion(entry.minDOFVersion);
+            lcc->LoadResolvedData(ledControlIniFilename, entry.colorData, entry.tableData, throwExceptions);
+
+            Log::Write(StringExtensions::Build("Loaded config for RomName {0} from cache file {1}", romName, cacheFilename));
+            m_cacheHit = true;
+            return lcc;
+         }
+      }
+   }
+
+   std::string fileData;
+   try
+   {
+      fileData = FileReader::ReadFileToString(ledControlIniFilename);
+   }
+   catch (const std::exception&)
+   {
+      return new LedControlConfig(ledControlIniFilename, ledWizNumber, romName, throwExceptions);
+   }
+   uint64_t contentHash = GetContentHash(fileData);
+   fileData.clear();
+
+   // Entries of other roms remain valid if only the timestamp of the file has changed.
+   std::vector<CacheEntry> entries;
+   if (cacheValid && header.contentHash == contentHash)
+   {
+      CacheReader entryReader(cacheData);
+      ReadHeader(entryReader, header);
+      for (uint32_t i = 0; i < header.entryCount; i++)
+      {
+         std::string_view entryRomName = entryReader.ReadString();
+         std::string_view entryData = entryReader.ReadString();
+         CacheEntry entry;
+         if (!entryReader.IsOk() || !ReadEntryData(entryData, entry))
+         {
+            entries.clear();
+            break;
+         }
+         if (entryRomName != romName)
+         {
+            entry.romName = entryRomName;
+            entries.push_back(std::move(entry));
+         }
+      }
+   }
+   else if (!cacheData.empty())
+   {
+      Log::Write(StringExtensions::Build("LedControl file {0} has changed. Rebuilding cache file {1}", ledControlIniFilename, cacheFilename));
+   }
+
+   LedControlConfig* lcc = new LedControlConfig(ledControlIniFilename, ledWizNumber, romName, throwExceptions);
+   if (!lcc->GetLedControlIniFile().empty())
+   {
+      CacheEntry entry;
+      entry.romName = romName;
+      entry.minDOFVersion = lcc->GetMinDOFVersion();
+      entry.colorData = lcc->GetResolvedColorData();
+      entry.tableData = lcc->GetResolvedTableData();
+      entries.push_back(std::move(entry));
+
+      if (!WriteCacheFile(cacheFilename, ledControlIniFilename, fileSize, lastWriteTime, contentHash, entries))
+         Log::Warning(StringExtensions::Build("Could not write LedControl cache file {0}.", cacheFilename));
+   }
+   return lcc;
+}
+
+uint32_t LedControlConfigCache::CacheReader::ReadUInt32()
+{
+   uint32_t value = 0;
+   if (!m_ok || m_pos + sizeof(value) > m_data.length())
+   {
+      m_ok = false;
+      return 0;
+   }
+   std::memcpy(&value, m_data.data() + m_pos, sizeof(value));
+   m_pos += sizeof(value);
+   return value;
+}
+
+uint64_t LedControlConfigCache::CacheReader::ReadUInt64()
+{
+   uint64_t value = 0;
+   if (!m_ok || m_pos + sizeof(value) > m_data.length())
+   {
+      m_ok = false;
+      return 0;
+   }
+   std::memcpy(&value, m_data.data() + m_pos, sizeof(value));
+   m_pos += sizeof(value);
+   return value;
+}
+
+std::string_view LedControlConfigCache::CacheReader::ReadString()
+{
+   uint32_t length = ReadUInt32();
+   if (!m_ok || m_pos + length > m_data.length())
+   {
+      m_ok = false;
+      return std::string_view();
+   }
+   std::string_view value = m_data.substr(m_pos, length);
+   m_pos += length;
+   return value;
+}
+
+bool LedControlConfigCache::ReadHeader(CacheReader& reader, CacheHeader& header)
+{
+   if (reader.ReadUInt32() != CacheFileMagic || reader.ReadUInt32() != CacheFileVersion)
+      return false;
+
+   header.sourceFilename = reader.ReadString();
+   header.fileSize = reader.ReadUInt64();
+   header.lastWriteTime = static_cast<int64_t>(reader.ReadUInt64());
+   header.contentHash = reader.ReadUInt64();
+   header.entryCount = reader.ReadUInt32();
+   return reader.IsOk();
+}
+
+bool LedControlConfigCache::ReadEntryData(std::string_view entryData, CacheEntry& entry)
+{
+   CacheReader reader(entryData);
+   entry.minDOFVersion = reader.ReadString();
+
+   uint32_t colorCount = reader.ReadUInt32();
+   for (uint32_t i = 0; i < colorCount && reader.IsOk(); i++)
+      entry.colorData.emplace_back(reader.ReadString());
+
+   uint32_t tableCount = reader.ReadUInt32();
+   for (uint32_t i = 0; i < tableCount && reader.IsOk(); i++)
+      entry.tableData.emplace_back(reader.ReadString());
+
+   return reader.IsOk();
+}
+
+void LedControlConfigCache::WriteUInt32(std::string& data, uint32_t value) { data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+void LedControlConfigCache::WriteUInt64(std::string& data, uint64_t value) { data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+void LedControlConfigCache::WriteString(std::string& data, std::string_view value)
+{
+   WriteUInt32(data, static_cast<uint32_t>(value.length()));
+   data.append(value);
+}
+
+uint64_t LedControlConfigCache::GetContentHash(const std::string& data)
+{
+   uint64_t hash = 14695981039346656037ULL;
+   for (unsigned char c : data)
+   {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+bool LedControlConfigCache::WriteCacheFile(const std::string& cacheFilename, const std::string& ledControlIniFilename, uint64_t fileSize, int64_t lastWriteTime, uint64_t contentHash,
+   const std::vector<CacheEntry>& entries)
+{
+   std::string data;
+   WriteUInt32(data, CacheFileMagic);
+   WriteUInt32(data, CacheFileVersion);
+   WriteString(data, ledControlIniFilename);
+   WriteUInt64(data, fileSize);
+   WriteUInt64(data, static_cast<uint64_t>(lastWriteTime));
+   WriteUInt64(data, contentHash);
+   WriteUInt32(data, static_cast<uint32_t>(entries.size()));
+
+   std::string entryData;
+   for (const CacheEntry& entry : entries)
+   {
+      entryData.clear();
+      WriteString(entryData, entry.minDOFVersion);
+      WriteUInt32(entryData, static_cast<uint32_t>(entry.colorData.size()));
+      for (const std::string& s : entry.colorData)
+         WriteString(entryData, s);
+      WriteUInt32(entryData, static_cast<uint32_t>(entry.tableData.size()));
+      for (const std::string& s : entry.tableData)
+         WriteString(entryData, s);
+
+      WriteString(data, entry.romName);
+      WriteString(data, entryData);
+   }
+
+   // Write to a temporary file first, so a concurrently starting instance never reads a partially written cache.
+   std::string tempFilename = cacheFilename + ".tmp";
+   {
+      std::ofstream out(tempFilename, std::ios::binary | std::ios::trunc);
+      if (!out)
+         return false;
+      out.write(data.data(), static_cast<std::streamsize>(data.size()));
+      if (!out)
+         return false;
+   }
+
+   std::error_code ec;
+   std::filesystem::rename(tempFilename, cacheFilename, ec);
+   if (ec)
+   {
+      std::filesystem::remove(tempFilename, ec);
+      return false;
+   }
+   return true;
+}
+
+}
\ No newline at end of file
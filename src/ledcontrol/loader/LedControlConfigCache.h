@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DOF/DOF.h"
+
+namespace DOF
+{
+
+class LedControlConfig;
+
+class LedControlConfigCache
+{
+public:
+   LedControlConfigCache(const std::string& cacheDirectory);
+   ~LedControlConfigCache();
+
+   LedControlConfig* Load(const std::string& ledControlIniFilename, int ledWizNumber, const std::string& romName, bool throwExceptions = false);
+   std::string GetCacheFilename(const std::string& ledControlIniFilename) const;
+   bool IsCacheHit() const { return m_cacheHit; }
+
+private:
+   struct CacheHeader
+   {
+      std::string_view sourceFilename;
+      uint64_t fileSize;
+      int64_t lastWriteTime;
+      uint64_t contentHash;
+      uint32_t entryCount;
+   };
+
+   struct CacheEntry
+   {
+      std::string romName;
+      std::string minDOFVersion;
+      std::vector<std::string> colorData;
+      std::vector<std::string> tableData;
+   };
+
+   class CacheReader
+   {
+   public:
+      CacheReader(std::string_view data)
+         : m_data(data)
+         , m_pos(0)
+         , m_ok(true)
+      {
+      }
+      bool IsOk() const { return m_ok; }
+      uint32_t ReadUInt32();
+      uint64_t ReadUInt64();
+      std::string_view ReadString();
+
+   private:
+      std::string_view m_data;
+      size_t m_pos;
+      bool m_ok;
+   };
+
+   static bool ReadHeader(CacheReader& reader, CacheHeader& header);
+   static bool ReadEntryData(std::string_view entryData, CacheEntry& entry);
+   static void WriteUInt32(std::string& data, uint32_t value);
+   static void WriteUInt64(std::string& data, uint64_t value);
+   static void WriteString(std::string& data, std::string_view value);
+   static uint64_t GetContentHash(const std::string& data);
+   bool WriteCacheFile(const std::string& cacheFilename, const std::string& ledControlIniFilename, uint64_t fileSize, int64_t lastWriteTime, uint64_t contentHash,
+      const std::vector<CacheEntry>& entries);
+
+   std::string m_cacheDirectory;
+   bool m_cacheHit;
+};
+
+}
\ No newline at end of file
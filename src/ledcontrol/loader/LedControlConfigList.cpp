@@ -1,5 +1,6 @@
 #include "LedControlConfigList.h"
 #include "LedControlConfig.h"
+#include "LedControlConfigCache.h"
 #include "TableConfig.h"
 #include "TableConfigList.h"
 #include "../../Log.h"
@@ -7,13 +8,23 @@
 #include "../../general/StringExtensions.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 namespace DOF
 {
 
-LedControlConfigList::LedControlConfigList() { }
+LedControlConfigList::LedControlConfigList()
+   : m_cacheHitCount(0)
+{
+}
 
-LedControlConfigList::LedControlConfigList(const std::vector<std::string>& ledControlFilenames, bool throwExceptions) { LoadLedControlFiles(ledControlFilenames, throwExceptions); }
+LedControlConfigList::LedControlConfigList(const std::vector<std::string>& ledControlFilenames, bool throwExceptions)
+   : m_cacheHitCount(0)
+{
+   LoadLedControlFiles(ledControlFilenames, throwExceptions);
+}
 
 LedControlConfigList::~LedControlConfigList()
 {
@@ -81,22 +92,92 @@ bool LedControlConfigList::ContainsConfig(const std::string& romName) { return G
 
 void LedControlConfigList::LoadLedControlFiles(const std::vector<std::string>& ledControlFilenames, bool throwExceptions)
 {
+   std::vector<std::pair<int, std::string>> ledControlFiles;
    for (int i = 0; i < static_cast<int>(ledControlFilenames.size()); i++)
-      LoadLedControlFile(ledControlFilenames[i], i + 1, throwExceptions);
+      ledControlFiles.emplace_back(i + 1, ledControlFilenames[i]);
+   LoadLedControlFiles(ledControlFiles, throwExceptions);
 }
 
 void LedControlConfigList::LoadLedControlFiles(const std::unordered_map<int, FileInfo>& ledControlIniFiles, bool throwExceptions)
 {
+   std::vector<std::pair<int, std::string>> ledControlFiles;
    for (const auto& f : ledControlIniFiles)
-      LoadLedControlFile(f.second.FullName(), f.first, throwExceptions);
+      ledControlFiles.emplace_back(f.first, f.second.FullName());
+   std::sort(ledControlFiles.begin(), ledControlFiles.end());
+   LoadLedControlFiles(ledControlFiles, throwExceptions);
+}
+
+void LedControlConfigList::LoadLedControlFiles(const std::vector<std::pair<int, std::string>>& ledControlFiles, bool throwExceptions)
+{
+   if (ledControlFiles.size() < 2)
+   {
+      for (const auto& f : ledControlFiles)
+         LoadLedControlFile(f.second, f.first, throwExceptions);
+      return;
+   }
+
+   // The files are parsed concurrently, but added in the order of the list so the result does not depend on thread scheduling.
+   std::vector<LedControlConfig*> configs(ledControlFiles.size(), nullptr);
+   std::vector<std::exception_ptr> errors(ledControlFiles.size());
+   std::atomic<size_t> nextFile(0);
+
+   auto loader = [&]()
+   {
+      for (size_t i = nextFile++; i < ledControlFiles.size(); i = nextFile++)
+      {
+         try
+         {
+            configs[i] = CreateLedControlConfig(ledControlFiles[i].second, ledControlFiles[i].first, throwExceptions);
+         }
+         catch (...)
+         {
+            errors[i] = std::current_exception();
+         }
+      }
+   };
+
+   int threadCount = std::min({ static_cast<int>(ledControlFiles.size()), static_cast<int>(std::max(1u, std::thread::hardware_concurrency())), MaxLoaderThreads });
+   std::vector<std::thread> threads;
+   for (int i = 1; i < threadCount; i++)
+      threads.emplace_back(loader);
+   loader();
+   for (std::thread& t : threads)
+      t.join();
+
+   std::exception_ptr firstError;
+   for (size_t i = 0; i < configs.size(); i++)
+   {
+      if (configs[i] != nullptr)
+         push_back(configs[i]);
+      if (errors[i] && !firstError)
+         firstError = errors[i];
+   }
+   if (firstError)
+      std::rethrow_exception(firstError);
 }
 
 void LedControlConfigList::LoadLedControlFile(const std::string& ledControlFilename, int ledWizNumber, bool throwExceptions)
+{
+   push_back(CreateLedControlConfig(ledControlFilename, ledWizNumber, throwExceptions));
+}
+
+LedControlConfig* LedControlConfigList::CreateLedControlConfig(const std::string& ledControlFilename, int ledWizNumber, bool throwExceptions)
 {
    Log::Write(StringExtensions::Build("Loading LedControl file {0}", ledControlFilename));
 
-   LedControlConfig* lcc = new LedControlConfig(ledControlFilename, ledWizNumber, throwExceptions);
-   push_back(lcc);
+   if (!m_romNameFilter.empty() && !m_cacheDirectory.empty())
+   {
+      LedControlConfigCache cache(m_cacheDirectory);
+      LedControlConfig* lcc = cache.Load(ledControlFilename, ledWizNumber, m_romNameFilter, throwExceptions);
+      if (cache.IsCacheHit())
+         m_cacheHitCount++;
+      return lcc;
+   }
+
+   if (!m_romNameFilter.empty())
+      return new LedControlConfig(ledControlFilename, ledWizNumber, m_romNameFilter, throwExceptions);
+
+   return new LedControlConfig(ledControlFilename, ledWizNumber, throwExceptions);
 }
 
 }
\ No newline at end of file
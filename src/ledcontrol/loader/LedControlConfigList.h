@@ -2,7 +2,9 @@
 
 #include "DOF/DOF.h"
 
+#include <atomic>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <string>
 
@@ -21,10 +23,25 @@ public:
    void LoadLedControlFiles(const std::vector<std::string>& ledControlFilenames, bool throwExceptions = false);
    void LoadLedControlFiles(const std::unordered_map<int, FileInfo>& ledControlIniFiles, bool throwExceptions = false);
    void LoadLedControlFile(const std::string& ledControlFilename, int ledWizNumber, bool throwExceptions = false);
+   const std::string& GetRomNameFilter() const { return m_romNameFilter; }
+   void SetRomNameFilter(const std::string& romName) { m_romNameFilter = romName; }
+   const std::string& GetCacheDirectory() const { return m_cacheDirectory; }
+   void SetCacheDirectory(const std::string& directory) { m_cacheDirectory = directory; }
+   int GetCacheHitCount() const { return m_cacheHitCount; }
    LedControlConfigList();
    LedControlConfigList(const std::vector<std::string>& ledControlFilenames, bool throwExceptions = false);
 
    ~LedControlConfigList();
+
+private:
+   static const int MaxLoaderThreads = 4;
+
+   void LoadLedControlFiles(const std::vector<std::pair<int, std::string>>& ledControlFiles, bool throwExceptions);
+   LedControlConfig* CreateLedControlConfig(const std::string& ledControlFilename, int ledWizNumber, bool throwExceptions);
+
+   std::string m_romNameFilter;
+   std::string m_cacheDirectory;
+   std::atomic<int> m_cacheHitCount;
 };
 
 }
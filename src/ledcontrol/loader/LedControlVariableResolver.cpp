@@ -0,0 +1,98 @@
+#include "LedControlVariableResolver.h"
+#include "TableVariablesDictionary.h"
+#include "../../general/StringExtensions.h"
+
+namespace DOF
+{
+
+void LedControlVariableResolver::ResolveTableVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData)
+{
+   TableVariablesDictionary vd(variableData);
+
+   std::unordered_map<std::string_view, VariableLookup> tableVariables;
+   for (const auto& kv : vd)
+      tableVariables[kv.first] = GetVariableLookup(kv.second);
+
+   std::string resolved;
+   for (size_t i = 0; i < dataToResolve.size(); i++)
+   {
+      const std::string& d = dataToResolve[i];
+      size_t tp = d.find(",");
+      if (tp != std::string::npos && tp > 0 && d.find('@') != std::string::npos)
+      {
+         auto it = tableVariables.find(StringExtensions::Trim(d.substr(0, tp)));
+         if (it != tableVariables.end())
+         {
+            resolved.clear();
+            SubstituteVariables(d, it->second, resolved, 0);
+            dataToResolve[i] = resolved;
+         }
+      }
+   }
+}
+
+void LedControlVariableResolver::ResolveVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData)
+{
+   VariablesDictionary vd(variableData);
+   VariableLookup variables = GetVariableLookup(vd);
+
+   std::string resolved;
+   for (size_t i = 0; i < dataToResolve.size(); i++)
+   {
+      if (dataToResolve[i].find('@') != std::string::npos)
+      {
+         resolved.clear();
+         SubstituteVariables(dataToResolve[i], variables, resolved, 0);
+         dataToResolve[i] = resolved;
+      }
+   }
+}
+
+LedControlVariableResolver::VariableLookup LedControlVariableResolver::GetVariableLookup(const VariablesDictionary& variables)
+{
+   VariableLookup lookup;
+   for (const auto& kv : variables)
+   {
+      std::string_view name = kv.first;
+      if (!name.empty() && name.front() == '@')
+         name.remove_prefix(1);
+      if (!name.empty() && name.back() == '@')
+         name.remove_suffix(1);
+      if (!name.empty())
+         lookup[name] = kv.second;
+   }
+   return lookup;
+}
+
+void LedControlVariableResolver::SubstituteVariables(std::string_view data, const VariableLookup& variables, std::string& result, int depth)
+{
+   size_t pos = 0;
+   while (pos < data.length())
+   {
+      size_t start = data.find('@', pos);
+      if (start == std::string_view::npos)
+         break;
+      size_t end = data.find('@', start + 1);
+      if (end == std::string_view::npos)
+         break;
+
+      auto it = variables.find(data.substr(start + 1, end - start - 1));
+      if (it == variables.end())
+      {
+         // The closing @ might open the next variable name.
+         result.append(data.substr(pos, end - pos));
+         pos = end;
+         continue;
+      }
+
+      result.append(data.substr(pos, start - pos));
+      if (depth < MaxVariableDepth && it->second.find('@') != std::string_view::npos)
+         SubstituteVariables(it->second, variables, result, depth + 1);
+      else
+         result.append(it->second);
+      pos = end + 1;
+   }
+   result.append(data.substr(pos));
+}
+
+}
\ No newline at end of file
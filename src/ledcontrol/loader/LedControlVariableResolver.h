@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "VariablesDictionary.h"
+
+namespace DOF
+{
+
+class LedControlVariableResolver
+{
+public:
+   static void ResolveTableVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData);
+   static void ResolveVariables(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData);
+
+private:
+   using VariableLookup = std::unordered_map<std::string_view, std::string_view>;
+   static const int MaxVariableDepth = 8;
+   static VariableLookup GetVariableLookup(const VariablesDictionary& variables);
+   static void SubstituteVariables(std::string_view data, const VariableLookup& variables, std::string& result, int depth);
+};
+
+}
\ No newline at end of file
@@ -298,6 +298,8 @@ std::unordered_map<int, std::unordered_map<int, IToy*>> Configurator::SetupCabin
 void Configurator::SetupTable(
    Table* table, const std::unordered_map<int, TableConfig*>& tableConfigDict, const std::unordered_map<int, std::unordered_map<int, IToy*>>& toyAssignments, const std::string& iniFilePath)
 {
+   std::set<std::string> bitmapFilePatterns;
+
    for (const auto& kv : tableConfigDict)
    {
       int ledWizNr = kv.first;
@@ -412,6 +414,16 @@ void Configurator::SetupTable(
                            p = StringExtensions::Build("{0}{1}{2}.*", iniFilePath, pathSeparator, tc->GetShortRomName());
                         }
 
+                        // Decoding starts right away, so images are ready or at least in progress when the effects are initialized.
+                        // The pattern is resolved with the same replace values the bitmap effects use in Init.
+                        if (bitmapFilePatterns.insert(p).second)
+                        {
+                           FileInfo* fi = FilePattern(p).GetFirstMatchingFile(m_replaceValues);
+                           if (fi != nullptr && fi->Exists())
+                              table->GetBitmaps().LoadAsync(fi->FullName());
+                           delete fi;
+                        }
+
                         if (tcs->GetAreaBitmapAnimationStepCount() > 1)
                         {
                            if (rgbaMatrixToy != nullptr)
@@ -1127,14 +1139,7 @@ void Configurator::AssignEffectToTableElements(Table* table, const std::vector<s
          TableElementData elementData(elementName, 0);
          tableElements->UpdateState(&elementData);
 
-         for (TableElement* te : *tableElements)
-         {
-            if (te->GetName() == elementName)
-            {
-               tableElement = te;
-               break;
-            }
-         }
+         tableElement = tableElements->Find(elementName);
       }
       else if (descriptor.find('.') != std::string::npos)
       {
@@ -1153,14 +1158,7 @@ void Configurator::AssignEffectToTableElements(Table* table, const std::vector<s
                TableElementData elementData(elementType, elementNumber, 0);
                tableElements->UpdateState(&elementData);
 
-               for (TableElement* te : *tableElements)
-               {
-                  if (te->GetTableElementType() == elementType && te->GetNumber() == elementNumber)
-                  {
-                     tableElement = te;
-                     break;
-                  }
-               }
+               tableElement = tableElements->Find(elementType, elementNumber);
             }
             catch (const std::exception&)
             {
@@ -1232,14 +1230,7 @@ void Configurator::AssignEffectToTableElements(Table* table, const std::vector<s
                   TableElementData elementData(elementType, number, 0);
                   tableElements->UpdateState(&elementData);
 
-                  for (TableElement* te : *tableElements)
-                  {
-                     if (te->GetTableElementType() == elementType && te->GetNumber() == number)
-                     {
-                        tableElement = te;
-                        break;
-                     }
-                  }
+                  tableElement = tableElements->Find(elementType, number);
                }
                catch (const std::exception&)
                {
@@ -24,11 +24,14 @@ public:
    void SetEffectMinDurationMs(int value) { m_effectMinDurationMs = value; }
    int GetEffectRGBMinDurationMs() const { return m_effectRGBMinDurationMs; }
    void SetEffectRGBMinDurationMs(int value) { m_effectRGBMinDurationMs = value; }
+   const std::unordered_map<std::string, std::string>& GetReplaceValues() const { return m_replaceValues; }
+   void SetReplaceValues(const std::unordered_map<std::string, std::string>& value) { m_replaceValues = value; }
    void Setup(LedControlConfigList* ledControlConfigList, Table* table, Cabinet* cabinet, const std::string& romName);
 
 private:
    int m_effectMinDurationMs;
    int m_effectRGBMinDurationMs;
+   std::unordered_map<std::string, std::string> m_replaceValues;
 
    void SetupTable(Table* table, const std::unordered_map<int, TableConfig*>& tableConfigDict, const std::unordered_map<int, std::unordered_map<int, IToy*>>& toyAssignments,
       const std::string& iniFilePath);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 namespace DOF
@@ -59,6 +60,16 @@ public:
 
    bool HasParameter() const { return m_hasParameter; }
 
+   struct Hash
+   {
+      size_t operator()(const Action& action) const
+      {
+         size_t h = std::hash<void*>()(action.m_target);
+         h ^= std::hash<void*>()(action.m_method) + 0x9e3779b9 + (h << 6) + (h >> 2);
+         return h ^ static_cast<size_t>(action.m_hasParameter);
+      }
+   };
+
 private:
    void* m_target;
    void* m_method;
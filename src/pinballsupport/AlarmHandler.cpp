@@ -8,7 +8,12 @@
 namespace DOF
 {
 
-AlarmHandler::AlarmHandler() { }
+AlarmHandler::AlarmHandler()
+   : m_nextAlarmId(0)
+   , m_nextFrameAlarm(TimePoint::min())
+   , m_frameIntervalMs(DefaultFrameIntervalMs)
+{
+}
 
 AlarmHandler::~AlarmHandler() { Finish(); }
 
@@ -18,8 +23,14 @@ void AlarmHandler::Finish()
 {
    std::lock_guard<std::recursive_mutex> alarmLock(m_alarmMutex);
    std::lock_guard<std::recursive_mutex> intervalLock(m_intervalAlarmMutex);
+   std::lock_guard<std::recursive_mutex> frameLock(m_frameAlarmMutex);
+   m_alarmQueue.clear();
    m_alarmList.clear();
+   m_alarmIds.clear();
+   m_intervalAlarmQueue.clear();
    m_intervalAlarmList.clear();
+   m_intervalAlarmIds.clear();
+   m_frameAlarmList.clear();
 }
 
 void AlarmHandler::RegisterAlarm(int durationMs, AlarmCallback alarmHandler, bool doNotUnregister)
@@ -30,53 +41,50 @@ void AlarmHandler::RegisterAlarm(int durationMs, AlarmCallback alarmHandler, boo
       UnregisterAlarm(alarmHandler);
 
    TimePoint alarmTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(durationMs);
-   m_alarmList.emplace_back(alarmTime, alarmHandler);
+   AddAlarm(alarmTime, AlarmSetting(alarmTime, alarmHandler));
 }
 
 void AlarmHandler::UnregisterAlarm(AlarmCallback alarmHandler)
 {
    std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
 
-   auto it = m_alarmList.begin();
-   while (it != m_alarmList.end())
-   {
-      if (it->alarmHandler == alarmHandler)
-      {
-         it = m_alarmList.erase(it);
-      }
-      else
-      {
-         ++it;
-      }
-   }
+   auto it = m_alarmIds.find(alarmHandler);
+   if (it == m_alarmIds.end())
+      return;
+
+   for (uint64_t id : it->second)
+      m_alarmList.erase(id);
+   m_alarmIds.erase(it);
 }
 
 AlarmHandler::TimePoint AlarmHandler::GetNextAlarmTime()
 {
    TimePoint nextAlarm = GetNextAlarm();
    TimePoint nextIntervalAlarm = GetNextIntervalAlarm();
-   return (nextIntervalAlarm < nextAlarm) ? nextIntervalAlarm : nextAlarm;
+   TimePoint nextFrameAlarm = GetNextFrameAlarm();
+   return std::min({ nextAlarm, nextIntervalAlarm, nextFrameAlarm });
 }
 
 bool AlarmHandler::ExecuteAlarms(TimePoint alarmTime)
 {
    bool result = ProcessAlarms(alarmTime);
    bool intervalResult = ProcessIntervalAlarms(alarmTime);
-   return result || intervalResult;
+   bool frameResult = ProcessFrameAlarms(alarmTime);
+   return result || intervalResult || frameResult;
 }
 
 AlarmHandler::TimePoint AlarmHandler::GetNextAlarm()
 {
    std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
 
-   if (m_alarmList.empty())
+   PruneAlarmQueue(m_alarmQueue, m_alarmList);
+
+   if (m_alarmQueue.empty())
    {
       return TimePoint::max();
    }
 
-   auto minElement = std::min_element(m_alarmList.begin(), m_alarmList.end(), [](const AlarmSetting& a, const AlarmSetting& b) { return a.alarmTime < b.alarmTime; });
-
-   return minElement->alarmTime;
+   return m_alarmQueue.front().alarmTime;
 }
 
 bool AlarmHandler::ProcessAlarms(TimePoint alarmTime)
@@ -86,10 +94,29 @@ bool AlarmHandler::ProcessAlarms(TimePoint alarmTime)
    {
       std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
 
-      auto it = std::partition(m_alarmList.begin(), m_alarmList.end(), [alarmTime](const AlarmSetting& alarm) { return alarm.alarmTime > alarmTime; });
+      PruneAlarmQueue(m_alarmQueue, m_alarmList);
 
-      std::move(it, m_alarmList.end(), std::back_inserter(toExecute));
-      m_alarmList.erase(it, m_alarmList.end());
+      while (!m_alarmQueue.empty() && m_alarmQueue.front().alarmTime <= alarmTime)
+      {
+         uint64_t id = m_alarmQueue.front().id;
+         PopAlarmQueue(m_alarmQueue);
+
+         auto it = m_alarmList.find(id);
+         if (it == m_alarmList.end())
+            continue;
+
+         auto idsIt = m_alarmIds.find(it->second.alarmHandler);
+         if (idsIt != m_alarmIds.end())
+         {
+            std::vector<uint64_t>& ids = idsIt->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            if (ids.empty())
+               m_alarmIds.erase(idsIt);
+         }
+
+         toExecute.push_back(std::move(it->second));
+         m_alarmList.erase(it);
+      }
    }
 
    bool alarmsExecuted = !toExecute.empty();
@@ -113,57 +140,60 @@ void AlarmHandler::RegisterIntervalAlarm(int intervalMs, AlarmCallback intervalA
    std::lock_guard<std::recursive_mutex> lock(m_intervalAlarmMutex);
 
    UnregisterIntervalAlarm(intervalAlarmHandler);
-   m_intervalAlarmList.emplace_back(intervalMs, intervalAlarmHandler);
+
+   uint64_t id = m_nextAlarmId++;
+   auto it = m_intervalAlarmList.emplace(id, IntervalAlarmSetting(intervalMs, intervalAlarmHandler)).first;
+   m_intervalAlarmIds[intervalAlarmHandler] = id;
+   PushAlarmQueue(m_intervalAlarmQueue, it->second.nextAlarm, id);
 }
 
 void AlarmHandler::UnregisterIntervalAlarm(AlarmCallback intervalAlarmHandler)
 {
    std::lock_guard<std::recursive_mutex> lock(m_intervalAlarmMutex);
 
-   auto it = m_intervalAlarmList.begin();
-   while (it != m_intervalAlarmList.end())
-   {
-      if (it->intervalAlarmHandler == intervalAlarmHandler)
-      {
-         it = m_intervalAlarmList.erase(it);
-      }
-      else
-      {
-         ++it;
-      }
-   }
+   auto it = m_intervalAlarmIds.find(intervalAlarmHandler);
+   if (it == m_intervalAlarmIds.end())
+      return;
+
+   m_intervalAlarmList.erase(it->second);
+   m_intervalAlarmIds.erase(it);
 }
 
 AlarmHandler::TimePoint AlarmHandler::GetNextIntervalAlarm()
 {
    std::lock_guard<std::recursive_mutex> lock(m_intervalAlarmMutex);
 
-   if (m_intervalAlarmList.empty())
+   PruneAlarmQueue(m_intervalAlarmQueue, m_intervalAlarmList);
+
+   if (m_intervalAlarmQueue.empty())
    {
       return TimePoint::max();
    }
 
-   auto minElement
-      = std::min_element(m_intervalAlarmList.begin(), m_intervalAlarmList.end(), [](const IntervalAlarmSetting& a, const IntervalAlarmSetting& b) { return a.nextAlarm < b.nextAlarm; });
-
-   return minElement->nextAlarm;
+   return m_intervalAlarmQueue.front().alarmTime;
 }
 
 bool AlarmHandler::ProcessIntervalAlarms(TimePoint alarmTime)
 {
    std::vector<AlarmCallback> toExecute;
-   std::vector<size_t> toUpdateIndices;
+   std::vector<uint64_t> toUpdateIds;
 
    {
       std::lock_guard<std::recursive_mutex> lock(m_intervalAlarmMutex);
 
-      for (size_t i = 0; i < m_intervalAlarmList.size(); ++i)
+      PruneAlarmQueue(m_intervalAlarmQueue, m_intervalAlarmList);
+
+      while (!m_intervalAlarmQueue.empty() && m_intervalAlarmQueue.front().alarmTime <= alarmTime)
       {
-         if (m_intervalAlarmList[i].nextAlarm <= alarmTime)
-         {
-            toExecute.push_back(m_intervalAlarmList[i].intervalAlarmHandler);
-            toUpdateIndices.push_back(i);
-         }
+         uint64_t id = m_intervalAlarmQueue.front().id;
+         PopAlarmQueue(m_intervalAlarmQueue);
+
+         auto it = m_intervalAlarmList.find(id);
+         if (it == m_intervalAlarmList.end())
+            continue;
+
+         toExecute.push_back(it->second.intervalAlarmHandler);
+         toUpdateIds.push_back(id);
       }
    }
 
@@ -183,11 +213,12 @@ bool AlarmHandler::ProcessIntervalAlarms(TimePoint alarmTime)
    {
       std::lock_guard<std::recursive_mutex> lock(m_intervalAlarmMutex);
 
-      for (size_t i : toUpdateIndices)
+      for (uint64_t id : toUpdateIds)
       {
-         if (i < m_intervalAlarmList.size())
+         auto it = m_intervalAlarmList.find(id);
+         if (it != m_intervalAlarmList.end())
          {
-            auto& intervalAlarm = m_intervalAlarmList[i];
+            auto& intervalAlarm = it->second;
             if (intervalAlarm.nextAlarm + std::chrono::milliseconds(intervalAlarm.intervalMs) <= alarmTime)
             {
                intervalAlarm.nextAlarm = alarmTime + std::chrono::milliseconds(1);
@@ -196,6 +227,7 @@ bool AlarmHandler::ProcessIntervalAlarms(TimePoint alarmTime)
             {
                intervalAlarm.nextAlarm = intervalAlarm.nextAlarm + std::chrono::milliseconds(intervalAlarm.intervalMs);
             }
+            PushAlarmQueue(m_intervalAlarmQueue, intervalAlarm.nextAlarm, id);
          }
       }
    }
@@ -211,7 +243,112 @@ void AlarmHandler::RegisterAlarm(int durationMs, AlarmCallback alarmHandler, voi
       UnregisterAlarm(alarmHandler);
 
    TimePoint alarmTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(durationMs);
-   m_alarmList.emplace_back(alarmTime, alarmHandler, parameter);
+   AddAlarm(alarmTime, AlarmSetting(alarmTime, alarmHandler, parameter));
+}
+
+void AlarmHandler::AddAlarm(TimePoint alarmTime, const AlarmSetting& alarm)
+{
+   uint64_t id = m_nextAlarmId++;
+   m_alarmList.emplace(id, alarm);
+   m_alarmIds[alarm.alarmHandler].push_back(id);
+   PushAlarmQueue(m_alarmQueue, alarmTime, id);
+}
+
+void AlarmHandler::PushAlarmQueue(AlarmQueue& queue, TimePoint alarmTime, uint64_t id)
+{
+   queue.push_back({ alarmTime, id });
+   std::push_heap(queue.begin(), queue.end(), std::greater<AlarmQueueEntry>());
+}
+
+void AlarmHandler::PopAlarmQueue(AlarmQueue& queue)
+{
+   std::pop_heap(queue.begin(), queue.end(), std::greater<AlarmQueueEntry>());
+   queue.pop_back();
+}
+
+template <typename T> void AlarmHandler::PruneAlarmQueue(AlarmQueue& queue, const std::unordered_map<uint64_t, T>& settings)
+{
+   if (queue.size() > 2 * settings.size() + 64)
+   {
+      queue.erase(std::remove_if(queue.begin(), queue.end(), [&settings](const AlarmQueueEntry& entry) { return settings.find(entry.id) == settings.end(); }), queue.end());
+      std::make_heap(queue.begin(), queue.end(), std::greater<AlarmQueueEntry>());
+   }
+
+   while (!queue.empty() && settings.find(queue.front().id) == settings.end())
+      PopAlarmQueue(queue);
+}
+
+void AlarmHandler::RegisterFrameAlarm(AlarmCallback frameAlarmHandler)
+{
+   std::lock_guard<std::recursive_mutex> lock(m_frameAlarmMutex);
+
+   if (std::find(m_frameAlarmList.begin(), m_frameAlarmList.end(), frameAlarmHandler) != m_frameAlarmList.end())
+      return;
+
+   if (m_frameAlarmList.empty())
+   {
+      TimePoint now = std::chrono::steady_clock::now();
+      if (m_nextFrameAlarm <= now)
+         m_nextFrameAlarm = now + std::chrono::milliseconds(m_frameIntervalMs);
+   }
+   m_frameAlarmList.push_back(frameAlarmHandler);
+}
+
+void AlarmHandler::UnregisterFrameAlarm(AlarmCallback frameAlarmHandler)
+{
+   std::lock_guard<std::recursive_mutex> lock(m_frameAlarmMutex);
+
+   m_frameAlarmList.erase(std::remove(m_frameAlarmList.begin(), m_frameAlarmList.end(), frameAlarmHandler), m_frameAlarmList.end());
+}
+
+void AlarmHandler::SetFrameIntervalMs(int value)
+{
+   std::lock_guard<std::recursive_mutex> lock(m_frameAlarmMutex);
+
+   m_frameIntervalMs = std::clamp(value, 1, 1000);
+}
+
+AlarmHandler::TimePoint AlarmHandler::GetNextFrameAlarm()
+{
+   std::lock_guard<std::recursive_mutex> lock(m_frameAlarmMutex);
+
+   if (m_frameAlarmList.empty())
+   {
+      return TimePoint::max();
+   }
+
+   return m_nextFrameAlarm;
+}
+
+bool AlarmHandler::ProcessFrameAlarms(TimePoint alarmTime)
+{
+   std::vector<AlarmCallback> toExecute;
+
+   {
+      std::lock_guard<std::recursive_mutex> lock(m_frameAlarmMutex);
+
+      if (m_frameAlarmList.empty() || m_nextFrameAlarm > alarmTime)
+         return false;
+
+      toExecute = m_frameAlarmList;
+
+      m_nextFrameAlarm += std::chrono::milliseconds(m_frameIntervalMs);
+      if (m_nextFrameAlarm <= alarmTime)
+         m_nextFrameAlarm = alarmTime + std::chrono::milliseconds(m_frameIntervalMs);
+   }
+
+   for (const auto& frameAlarmHandler : toExecute)
+   {
+      try
+      {
+         frameAlarmHandler();
+      }
+      catch (...)
+      {
+      }
+   }
+
+   return true;
 }
 
 }
\ No newline at end of file
@@ -2,11 +2,14 @@
 
 #include "DOF/DOF.h"
 #include "Action.h"
+#include <atomic>
 #include <functional>
 #include <vector>
 #include <mutex>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 
 namespace DOF
 {
@@ -20,6 +23,8 @@ public:
    using AlarmCallback = Action;
    using TimePoint = std::chrono::steady_clock::time_point;
 
+   static const int DefaultFrameIntervalMs = 30;
+
    AlarmHandler();
    ~AlarmHandler();
 
@@ -32,6 +37,12 @@ public:
 
    void RegisterIntervalAlarm(int intervalMs, AlarmCallback intervalAlarmHandler);
    void UnregisterIntervalAlarm(AlarmCallback intervalAlarmHandler);
+
+   void RegisterFrameAlarm(AlarmCallback frameAlarmHandler);
+   void UnregisterFrameAlarm(AlarmCallback frameAlarmHandler);
+   int GetFrameIntervalMs() const { return m_frameIntervalMs; }
+   void SetFrameIntervalMs(int value);
+
    TimePoint GetNextAlarmTime();
    bool ExecuteAlarms(TimePoint alarmTime);
 
@@ -82,15 +93,45 @@ private:
       }
    };
 
+   // Alarms are kept in a min-heap of (time, id) entries. Unregistering only drops the id from the
+   // settings map, the stale heap entry is skipped when it reaches the top of the heap.
+   struct AlarmQueueEntry
+   {
+      TimePoint alarmTime;
+      uint64_t id;
+
+      bool operator>(const AlarmQueueEntry& other) const { return alarmTime > other.alarmTime || (alarmTime == other.alarmTime && id > other.id); }
+   };
+
+   using AlarmQueue = std::vector<AlarmQueueEntry>;
+
    std::recursive_mutex m_alarmMutex;
    std::recursive_mutex m_intervalAlarmMutex;
-   std::vector<AlarmSetting> m_alarmList;
-   std::vector<IntervalAlarmSetting> m_intervalAlarmList;
+   AlarmQueue m_alarmQueue;
+   std::unordered_map<uint64_t, AlarmSetting> m_alarmList;
+   std::unordered_map<AlarmCallback, std::vector<uint64_t>, AlarmCallback::Hash> m_alarmIds;
+   AlarmQueue m_intervalAlarmQueue;
+   std::unordered_map<uint64_t, IntervalAlarmSetting> m_intervalAlarmList;
+   std::unordered_map<AlarmCallback, uint64_t, AlarmCallback::Hash> m_intervalAlarmIds;
+   std::atomic<uint64_t> m_nextAlarmId;
+
+   // All frame alarms share a single deadline, so every animated effect is stepped in the
+   // same main loop pass and the cabinet is updated once per frame.
+   std::recursive_mutex m_frameAlarmMutex;
+   std::vector<AlarmCallback> m_frameAlarmList;
+   TimePoint m_nextFrameAlarm;
+   int m_frameIntervalMs;
 
    TimePoint GetNextAlarm();
    TimePoint GetNextIntervalAlarm();
+   TimePoint GetNextFrameAlarm();
    bool ProcessAlarms(TimePoint alarmTime);
    bool ProcessIntervalAlarms(TimePoint alarmTime);
+   bool ProcessFrameAlarms(TimePoint alarmTime);
+   void AddAlarm(TimePoint alarmTime, const AlarmSetting& alarm);
+   static void PushAlarmQueue(AlarmQueue& queue, TimePoint alarmTime, uint64_t id);
+   static void PopAlarmQueue(AlarmQueue& queue);
+   template <typename T> static void PruneAlarmQueue(AlarmQueue& queue, const std::unordered_map<uint64_t, T>& settings);
 };
 
 }
\ No newline at end of file
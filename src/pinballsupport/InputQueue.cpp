@@ -6,56 +6,231 @@
 namespace DOF
 {
 
-InputQueue::InputQueue() { }
+InputQueue::InputQueue()
+   : m_buffer(new Cell[Capacity])
+   , m_enqueuePos(0)
+   , m_dequeuePos(0)
+   , m_droppedCount(0)
+   , m_coalescing(false)
+   , m_coalescedCount(0)
+{
+   for (size_t i = 0; i < Capacity; i++)
+      m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+InputQueue::~InputQueue() { delete[] m_buffer; }
 
-void InputQueue::Enqueue(char tableElementTypeChar, int number, int value) { Enqueue(TableElementData(tableElementTypeChar, number, value)); }
+bool InputQueue::Enqueue(char tableElementTypeChar, int number, int value) { return Enqueue(TableElementData(tableElementTypeChar, number, value)); }
 
-void InputQueue::Enqueue(const TableElementData& tableElementData)
+bool InputQueue::Enqueue(const TableElementData& tableElementData)
 {
-   std::lock_guard<std::mutex> lock(m_queueLocker);
-   this->push(tableElementData);
+   InputEvent inputEvent;
+   inputEvent.tableElementType = tableElementData.m_tableElementType;
+   inputEvent.number = tableElementData.m_number;
+   inputEvent.value = tableElementData.m_value;
+   inputEvent.nameId = tableElementData.m_name.empty() ? -1 : GetNameId(tableElementData.m_name);
+   return Enqueue(inputEvent);
 }
 
-void InputQueue::Enqueue(const std::string& tableElementName, int value)
+bool InputQueue::Enqueue(const std::string& tableElementName, int value)
 {
    if (StringExtensions::IsNullOrWhiteSpace(tableElementName))
-      return;
+      return false;
 
    std::string cleanedName = StringExtensions::Replace(tableElementName, " ", "_");
 
-   std::lock_guard<std::mutex> lock(m_queueLocker);
-   this->push(TableElementData(cleanedName, value));
+   return Enqueue(TableElementData(cleanedName, value));
+}
+
+bool InputQueue::Enqueue(const InputEvent& inputEvent)
+{
+   size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+   Cell* cell;
+
+   while (true)
+   {
+      cell = &m_buffer[pos & (Capacity - 1)];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0)
+      {
+         if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+      }
+      else if (diff < 0)
+      {
+         m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+         return false;
+      }
+      else
+      {
+         pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+   }
+
+   cell->data = inputEvent;
+   cell->sequence.store(pos + 1, std::memory_order_release);
+   return true;
+}
+
+bool InputQueue::TryDequeue(InputEvent& inputEvent)
+{
+   size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+   Cell* cell = &m_buffer[pos & (Capacity - 1)];
+   if (cell->sequence.load(std::memory_order_acquire) != pos + 1)
+      return false;
+
+   inputEvent = cell->data;
+   cell->sequence.store(pos + Capacity, std::memory_order_release);
+   m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+   return true;
 }
 
 TableElementData InputQueue::Dequeue()
 {
-   std::lock_guard<std::mutex> lock(m_queueLocker);
-   if (this->empty())
+   InputEvent inputEvent;
+   if (!TryDequeue(inputEvent))
       throw std::runtime_error("Queue is empty");
-   TableElementData frontElement = this->front();
-   this->pop();
-   return frontElement;
+   return ToTableElementData(inputEvent);
+}
+
+int InputQueue::DequeueBatch(std::vector<TableElementData>& tableElementDataList, int maxCount)
+{
+   tableElementDataList.clear();
+
+   InputEvent inputEvent;
+   if (!m_coalescing)
+   {
+      while (static_cast<int>(tableElementDataList.size()) < maxCount && TryDequeue(inputEvent))
+         tableElementDataList.push_back(ToTableElementData(inputEvent));
+
+      return static_cast<int>(tableElementDataList.size());
+   }
+
+   m_batch.clear();
+   while (static_cast<int>(m_batch.size()) < maxCount && TryDequeue(inputEvent))
+      m_batch.push_back(inputEvent);
+
+   int dequeuedCount = static_cast<int>(m_batch.size());
+   CoalesceBatch();
+
+   for (const InputEvent& e : m_batch)
+      tableElementDataList.push_back(ToTableElementData(e));
+
+   return dequeuedCount;
+}
+
+void InputQueue::CoalesceBatch()
+{
+   m_batchIndex.clear();
+
+   size_t keptCount = 0;
+   for (size_t i = 0; i < m_batch.size(); i++)
+   {
+      const InputEvent& inputEvent = m_batch[i];
+      uint64_t key = GetElementKey(inputEvent);
+
+      auto it = m_batchIndex.find(key);
+      if (it != m_batchIndex.end())
+      {
+         InputEvent& kept = m_batch[it->second];
+         if (m_keepAllEdgesKeys.find(key) == m_keepAllEdgesKeys.end() || (kept.value != 0) == (inputEvent.value != 0))
+         {
+            kept.value = inputEvent.value;
+            m_coalescedCount++;
+            continue;
+         }
+         it->second = keptCount;
+      }
+      else
+      {
+         m_batchIndex.emplace(key, keptCount);
+      }
+
+      m_batch[keptCount++] = inputEvent;
+   }
+
+   m_batch.resize(keptCount);
+}
+
+void InputQueue::SetKeepAllEdges(TableElementTypeEnum tableElementType, int number, bool keepAllEdges)
+{
+   InputEvent inputEvent { tableElementType, number, 0, -1 };
+   if (keepAllEdges)
+      m_keepAllEdgesKeys.insert(GetElementKey(inputEvent));
+   else
+      m_keepAllEdgesKeys.erase(GetElementKey(inputEvent));
+}
+
+void InputQueue::SetKeepAllEdges(const std::string& tableElementName, bool keepAllEdges)
+{
+   InputEvent inputEvent { TableElementTypeEnum::NamedElement, 0, 0, GetNameId(StringExtensions::Replace(tableElementName, " ", "_")) };
+   if (keepAllEdges)
+      m_keepAllEdgesKeys.insert(GetElementKey(inputEvent));
+   else
+      m_keepAllEdgesKeys.erase(GetElementKey(inputEvent));
+}
+
+uint64_t InputQueue::GetElementKey(const InputEvent& inputEvent)
+{
+   if (inputEvent.nameId >= 0)
+      return (static_cast<uint64_t>(TableElementTypeEnum::NamedElement) << 32) | static_cast<uint32_t>(inputEvent.nameId);
+
+   return (static_cast<uint64_t>(inputEvent.tableElementType) << 32) | static_cast<uint32_t>(inputEvent.number);
 }
 
 TableElementData InputQueue::Peek()
 {
-   std::lock_guard<std::mutex> lock(m_queueLocker);
-   if (this->empty())
+   size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+   Cell* cell = &m_buffer[pos & (Capacity - 1)];
+   if (cell->sequence.load(std::memory_order_acquire) != pos + 1)
       throw std::runtime_error("Queue is empty");
-   return this->front();
+   return ToTableElementData(cell->data);
+}
+
+int InputQueue::Count() const
+{
+   size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+   size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+   return enqueuePos > dequeuePos ? static_cast<int>(enqueuePos - dequeuePos) : 0;
 }
 
-int InputQueue::Count()
+bool InputQueue::IsEmpty() const
 {
-   std::lock_guard<std::mutex> lock(m_queueLocker);
-   return static_cast<int>(this->size());
+   size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+   return m_buffer[pos & (Capacity - 1)].sequence.load(std::memory_order_acquire) != pos + 1;
 }
 
 void InputQueue::Clear()
 {
-   std::lock_guard<std::mutex> lock(m_queueLocker);
-   std::queue<TableElementData> empty;
-   std::swap(*this, empty);
+   InputEvent inputEvent;
+   while (TryDequeue(inputEvent))
+   {
+   }
+}
+
+int InputQueue::GetNameId(const std::string& name)
+{
+   std::lock_guard<std::mutex> lock(m_nameLocker);
+   auto it = m_nameIds.find(name);
+   if (it != m_nameIds.end())
+      return it->second;
+
+   int nameId = static_cast<int>(m_names.size());
+   m_names.push_back(name);
+   m_nameIds.emplace(name, nameId);
+   return nameId;
+}
+
+TableElementData InputQueue::ToTableElementData(const InputEvent& inputEvent)
+{
+   TableElementData tableElementData(inputEvent.tableElementType, inputEvent.number, inputEvent.value);
+   if (inputEvent.nameId >= 0)
+   {
+      std::lock_guard<std::mutex> lock(m_nameLocker);
+      tableElementData.m_name = m_names[inputEvent.nameId];
+   }
+   return tableElementData;
 }
 
 }
\ No newline at end of file
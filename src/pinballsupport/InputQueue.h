@@ -1,28 +1,84 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
-#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "../table/TableElementData.h"
 #include "DOF/DOF.h"
 
 namespace DOF
 {
-class InputQueue : public std::queue<TableElementData>
+
+// Bounded multi producer, single consumer ring of compact input events. Typed input (type, number, value)
+// is enqueued without locking or allocating. Named table elements are interned once and carried as ids.
+// With coalescing enabled, DequeueBatch only returns the latest value per table element of the drained events.
+// Elements flagged with SetKeepAllEdges keep every on/off transition and only lose intermediate values.
+class InputQueue
 {
 public:
    InputQueue();
+   ~InputQueue();
 
-   void Enqueue(char tableElementTypeChar, int number, int value);
-   void Enqueue(const TableElementData& tableElementData);
-   void Enqueue(const std::string& tableElementName, int value);
+   bool Enqueue(char tableElementTypeChar, int number, int value);
+   bool Enqueue(const TableElementData& tableElementData);
+   bool Enqueue(const std::string& tableElementName, int value);
    TableElementData Dequeue();
+   int DequeueBatch(std::vector<TableElementData>& tableElementDataList, int maxCount);
    TableElementData Peek();
-   int Count();
+   int Count() const;
+   bool IsEmpty() const;
    void Clear();
+   uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+   bool IsCoalescing() const { return m_coalescing; }
+   void SetCoalescing(bool value) { m_coalescing = value; }
+   void SetKeepAllEdges(TableElementTypeEnum tableElementType, int number, bool keepAllEdges);
+   void SetKeepAllEdges(const std::string& tableElementName, bool keepAllEdges);
+   uint64_t GetCoalescedCount() const { return m_coalescedCount; }
+
+   static const size_t Capacity = 16384;
 
 private:
-   std::mutex m_queueLocker;
+   struct InputEvent
+   {
+      TableElementTypeEnum tableElementType;
+      int number;
+      int value;
+      int nameId;
+   };
+
+   struct Cell
+   {
+      std::atomic<size_t> sequence;
+      InputEvent data;
+   };
+
+   bool Enqueue(const InputEvent& inputEvent);
+   bool TryDequeue(InputEvent& inputEvent);
+   int GetNameId(const std::string& name);
+   static uint64_t GetElementKey(const InputEvent& inputEvent);
+   void CoalesceBatch();
+   TableElementData ToTableElementData(const InputEvent& inputEvent);
+
+   Cell* m_buffer;
+   alignas(64) std::atomic<size_t> m_enqueuePos;
+   alignas(64) std::atomic<size_t> m_dequeuePos;
+   std::atomic<uint64_t> m_droppedCount;
+
+   bool m_coalescing;
+   uint64_t m_coalescedCount;
+   std::unordered_set<uint64_t> m_keepAllEdgesKeys;
+   std::vector<InputEvent> m_batch;
+   std::unordered_map<uint64_t, size_t> m_batchIndex;
+
+   std::mutex m_nameLocker;
+   std::unordered_map<std::string, int> m_nameIds;
+   std::vector<std::string> m_names;
 };
 
 }
\ No newline at end of file
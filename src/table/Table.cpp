@@ -325,7 +325,7 @@ Table* Table::FromXml(const std::string& configXml)
             tableElement = new TableElement(type, number, 0);
 
          if (tableElement)
-            table->GetTableElements()->push_back(tableElement);
+            table->GetTableElements()->Add(tableElement);
 
          tableElementNode = tableElementNode->NextSiblingElement("TableElement");
       }
@@ -38,36 +38,38 @@ void TableElementList::UpdateState(TableElementData* data)
    TableElement* targetElement = nullptr;
 
    if (!data->m_name.empty())
-   {
-      for (TableElement* element : *this)
-      {
-         if (element && element->GetName() == data->m_name)
-         {
-            targetElement = element;
-            break;
-         }
-      }
-   }
+      targetElement = Find(data->m_name);
 
    if (!targetElement)
-   {
-      for (TableElement* element : *this)
-      {
-         if (element && element->GetTableElementType() == data->m_tableElementType && element->GetNumber() == data->m_number)
-         {
-            targetElement = element;
-            break;
-         }
-      }
-   }
+      targetElement = Find(data->m_tableElementType, data->m_number);
 
    if (targetElement)
       targetElement->SetValue(data->m_value);
    else
-   {
-      TableElement* newElement = new TableElement(data->m_tableElementType, data->m_number, data->m_value);
-      push_back(newElement);
-   }
+      Add(new TableElement(data->m_tableElementType, data->m_number, data->m_value));
+}
+
+void TableElementList::Add(TableElement* tableElement)
+{
+   if (!tableElement)
+      return;
+
+   push_back(tableElement);
+   m_numberIndex.emplace(GetNumberKey(tableElement->GetTableElementType(), tableElement->GetNumber()), tableElement);
+   if (!tableElement->GetName().empty())
+      m_nameIndex.emplace(tableElement->GetName(), tableElement);
+}
+
+TableElement* TableElementList::Find(TableElementTypeEnum tableElementType, int number) const
+{
+   auto it = m_numberIndex.find(GetNumberKey(tableElementType, number));
+   return it != m_numberIndex.end() ? it->second : nullptr;
+}
+
+TableElement* TableElementList::Find(const std::string& name) const
+{
+   auto it = m_nameIndex.find(name);
+   return it != m_nameIndex.end() ? it->second : nullptr;
 }
 
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "DOF/DOF.h"
+#include "TableElementTypeEnum.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace DOF
 {
@@ -16,8 +21,15 @@ public:
    void Init(Table* table);
    void FinishAssignedEffects();
    void UpdateState(TableElementData* data);
+   void Add(TableElement* tableElement);
+   TableElement* Find(TableElementTypeEnum tableElementType, int number) const;
+   TableElement* Find(const std::string& name) const;
 
 private:
+   static uint64_t GetNumberKey(TableElementTypeEnum tableElementType, int number) { return (static_cast<uint64_t>(tableElementType) << 32) | static_cast<uint32_t>(number); }
+
+   std::unordered_map<uint64_t, TableElement*> m_numberIndex;
+   std::unordered_map<std::string, TableElement*> m_nameIndex;
 };
 
-}
+}
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "pinballsupport/AlarmHandler.h"
+#include "pinballsupport/Action.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using namespace DOF;
+
+// One-shot alarm registration of AlarmHandler as it was before the alarms were indexed in a min-heap, used as reference.
+class AlarmHandlerReference
+{
+public:
+   using TimePoint = std::chrono::steady_clock::time_point;
+
+   void RegisterAlarm(int durationMs, Action alarmHandler)
+   {
+      std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
+
+      UnregisterAlarm(alarmHandler);
+
+      TimePoint alarmTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(durationMs);
+      m_alarmList.push_back({ alarmTime, alarmHandler });
+   }
+
+   void UnregisterAlarm(Action alarmHandler)
+   {
+      std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
+
+      auto it = m_alarmList.begin();
+      while (it != m_alarmList.end())
+      {
+         if (it->alarmHandler == alarmHandler)
+            it = m_alarmList.erase(it);
+         else
+            ++it;
+      }
+   }
+
+   TimePoint GetNextAlarmTime()
+   {
+      std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
+
+      if (m_alarmList.empty())
+         return TimePoint::max();
+
+      auto minElement = std::min_element(m_alarmList.begin(), m_alarmList.end(), [](const AlarmSetting& a, const AlarmSetting& b) { return a.alarmTime < b.alarmTime; });
+      return minElement->alarmTime;
+   }
+
+   bool ExecuteAlarms(TimePoint alarmTime)
+   {
+      std::vector<AlarmSetting> toExecute;
+      {
+         std::lock_guard<std::recursive_mutex> lock(m_alarmMutex);
+
+         auto it = std::partition(m_alarmList.begin(), m_alarmList.end(), [alarmTime](const AlarmSetting& alarm) { return alarm.alarmTime > alarmTime; });
+         std::move(it, m_alarmList.end(), std::back_inserter(toExecute));
+         m_alarmList.erase(it, m_alarmList.end());
+      }
+
+      for (const AlarmSetting& alarm : toExecute)
+         alarm.alarmHandler();
+      return !toExecute.empty();
+   }
+
+private:
+   struct AlarmSetting
+   {
+      TimePoint alarmTime;
+      Action alarmHandler;
+   };
+
+   std::recursive_mutex m_alarmMutex;
+   std::vector<AlarmSetting> m_alarmList;
+};
+
+class BenchTarget
+{
+public:
+   void OnAlarm() { s_fired.push_back(m_index); }
+
+   int m_index = 0;
+   static std::vector<int> s_fired;
+};
+
+std::vector<int> BenchTarget::s_fired;
+
+template <typename Handler> static void RunBenchmark(const char* name, std::vector<BenchTarget>& targets, const std::vector<int>& durations)
+{
+   Handler handler;
+   int alarmCount = static_cast<int>(targets.size());
+
+   auto start = std::chrono::steady_clock::now();
+   for (int i = 0; i < alarmCount; i++)
+   {
+      handler.RegisterAlarm(durations[i], Action(&targets[i], &BenchTarget::OnAlarm));
+      handler.GetNextAlarmTime();
+   }
+   auto registered = std::chrono::steady_clock::now();
+
+   for (int i = 0; i < alarmCount; i++)
+   {
+      handler.UnregisterAlarm(Action(&targets[i], &BenchTarget::OnAlarm));
+      handler.GetNextAlarmTime();
+   }
+   auto cancelled = std::chrono::steady_clock::now();
+
+   auto registerMs = std::chrono::duration_cast<std::chrono::microseconds>(registered - start).count() / 1000.0;
+   auto cancelMs = std::chrono::duration_cast<std::chrono::microseconds>(cancelled - registered).count() / 1000.0;
+   std::cout << name << ": register " << alarmCount << " alarms in " << registerMs << " ms, cancel in " << cancelMs << " ms, total " << (registerMs + cancelMs) << " ms"
+             << std::endl;
+}
+
+// Registers every alarm, re-registers and cancels some of them and checks that the rest fire in deadline order, ties in registration order.
+template <typename Handler> static std::vector<int> GetFiringOrder(std::vector<BenchTarget>& targets, const std::vector<int>& durations)
+{
+   Handler handler;
+   int alarmCount = static_cast<int>(targets.size());
+   for (int i = 0; i < alarmCount; i++)
+      handler.RegisterAlarm(durations[i], Action(&targets[i], &BenchTarget::OnAlarm));
+   for (int i = 0; i < alarmCount; i += 7)
+      handler.RegisterAlarm(durations[(i * 13) % alarmCount], Action(&targets[i], &BenchTarget::OnAlarm));
+   for (int i = 3; i < alarmCount; i += 5)
+      handler.UnregisterAlarm(Action(&targets[i], &BenchTarget::OnAlarm));
+
+   BenchTarget::s_fired.clear();
+   handler.ExecuteAlarms(std::chrono::steady_clock::now() + std::chrono::hours(1));
+   return BenchTarget::s_fired;
+}
+
+int main(int argc, char* argv[])
+{
+   int alarmCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 10000;
+
+   std::cout << "AlarmHandler Benchmark Program" << std::endl;
+   std::cout << "==============================" << std::endl;
+   std::cout << "Registers and cancels " << alarmCount << " one-shot alarms with AlarmHandler and with the previous vector based implementation" << std::endl;
+
+   std::vector<BenchTarget> targets(alarmCount);
+   for (int i = 0; i < alarmCount; i++)
+      targets[i].m_index = i;
+
+   std::mt19937 rng(42);
+   std::vector<int> durations(alarmCount);
+   for (int& d : durations)
+      d = 1000 + static_cast<int>(rng() % 60000);
+
+   RunBenchmark<AlarmHandler>("AlarmHandler", targets, durations);
+   RunBenchmark<AlarmHandlerReference>("Reference", targets, durations);
+
+   // The registrations run at slightly different times, so the firing order is compared on a small set with coarse, colliding durations.
+   int orderCount = std::min(alarmCount, 500);
+   std::vector<BenchTarget> orderTargets(targets.begin(), targets.begin() + orderCount);
+   std::vector<int> orderDurations(orderCount);
+   for (int& d : orderDurations)
+      d = 60000 * static_cast<int>(1 + rng() % 4);
+
+   std::vector<int> fired = GetFiringOrder<AlarmHandler>(orderTargets, orderDurations);
+   std::vector<int> referenceFired = GetFiringOrder<AlarmHandlerReference>(orderTargets, orderDurations);
+
+   // Alarms with the same deadline fire in registration order. A re-registered alarm counts as registered last.
+   std::vector<int> expected;
+   for (int i = 0; i < orderCount; i++)
+   {
+      if (i % 7 != 0 && i % 5 != 3)
+         expected.push_back(i);
+   }
+   for (int i = 0; i < orderCount; i += 7)
+   {
+      if (i % 5 != 3)
+         expected.push_back(i);
+   }
+   auto getDuration = [&](int index) { return (index % 7 == 0) ? orderDurations[(index * 13) % orderCount] : orderDurations[index]; };
+   std::stable_sort(expected.begin(), expected.end(), [&](int a, int b) { return getDuration(a) < getDuration(b); });
+
+   std::vector<int> sortedReference = referenceFired;
+   std::vector<int> sortedExpected = expected;
+   std::sort(sortedReference.begin(), sortedReference.end());
+   std::sort(sortedExpected.begin(), sortedExpected.end());
+
+   bool ok = fired == expected && sortedReference == sortedExpected;
+   std::cout << "Firing order: " << fired.size() << " alarms fired, reference " << referenceFired.size() << ", " << (ok ? "OK" : "MISMATCH") << std::endl;
+   return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,304 @@
+#include "general/bitmap/FastBitmap.h"
+#include "general/MathExtensions.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <climits>
+#include <random>
+#include <string>
+
+using namespace DOF;
+
+// GetClip as it was before the blend weights were precomputed and summed with SSE2/NEON, used as reference for bit-exact results.
+static FastBitmap GetClipReference(const FastBitmap& src, int resultWidth, int resultHeight, int sourceLeft, int sourceTop, int sourceWidth, int sourceHeight, FastBitmapDataExtractModeEnum dataExtractMode)
+{
+   sourceLeft = MathExtensions::Limit(sourceLeft, 0, src.GetWidth() - 1);
+   sourceTop = MathExtensions::Limit(sourceTop, 0, src.GetHeight() - 1);
+   sourceWidth = (sourceWidth < 0) ? src.GetWidth() - sourceLeft : sourceWidth;
+   sourceHeight = (sourceHeight < 0) ? src.GetHeight() - sourceTop : sourceHeight;
+   resultWidth = MathExtensions::Limit(resultWidth, 0, INT_MAX);
+   resultHeight = MathExtensions::Limit(resultHeight, 0, INT_MAX);
+
+   FastBitmap result;
+   result = FastBitmap(resultWidth, resultHeight);
+
+   switch (dataExtractMode)
+   {
+   case FastBitmapDataExtractModeEnum::BlendPixels:
+   {
+      float red = 0.0f;
+      float green = 0.0f;
+      float blue = 0.0f;
+      float alpha = 0.0f;
+      float weight = 0.0f;
+
+      float pixelSourceWidth = static_cast<float>(sourceWidth) / resultWidth;
+      float pixelSourceHeight = static_cast<float>(sourceHeight) / resultHeight;
+      float pixelSourceCount = pixelSourceWidth * pixelSourceHeight;
+
+      for (int y = 0; y < resultHeight; y++)
+      {
+         float pixelSourceTop = sourceTop + y * pixelSourceHeight;
+         float pixelSourceBottom = pixelSourceTop + pixelSourceHeight;
+
+         for (int x = 0; x < resultWidth; x++)
+         {
+            int psr = 0;
+            int psb = 0;
+            float pixelSourceLeft = sourceLeft + x * pixelSourceWidth;
+            float pixelSourceRight = pixelSourceLeft + pixelSourceWidth;
+            red = 0.0f;
+            green = 0.0f;
+            blue = 0.0f;
+            alpha = 0.0f;
+
+            if (!MathExtensions::IsIntegral(pixelSourceTop))
+            {
+               if (!MathExtensions::IsIntegral(pixelSourceLeft))
+               {
+                  PixelData pd = src.GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceLeft)), static_cast<int>(MathExtensions::Floor(pixelSourceTop)));
+                  weight = (MathExtensions::Ceiling(pixelSourceTop) - pixelSourceTop) * (MathExtensions::Ceiling(pixelSourceLeft) - pixelSourceLeft);
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+
+               psr = static_cast<int>(MathExtensions::Floor(pixelSourceRight));
+               weight = (MathExtensions::Ceiling(pixelSourceTop) - pixelSourceTop);
+               for (int xs = static_cast<int>(MathExtensions::Ceiling(pixelSourceLeft)); xs < psr; xs++)
+               {
+                  PixelData pd = src.GetPixel(xs, static_cast<int>(MathExtensions::Floor(pixelSourceTop)));
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+
+               if (!MathExtensions::IsIntegral(pixelSourceRight))
+               {
+                  weight = (MathExtensions::Ceiling(pixelSourceTop) - pixelSourceTop) * (pixelSourceRight - MathExtensions::Floor(pixelSourceRight));
+                  PixelData pd = src.GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceRight)), static_cast<int>(MathExtensions::Floor(pixelSourceTop)));
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+            }
+
+            psb = static_cast<int>(MathExtensions::Floor(pixelSourceBottom));
+            psr = static_cast<int>(MathExtensions::Floor(pixelSourceRight));
+            for (int ys = static_cast<int>(MathExtensions::Ceiling(pixelSourceTop)); ys < psb; ys++)
+            {
+               if (!MathExtensions::IsIntegral(pixelSourceLeft))
+               {
+                  PixelData pd = src.GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceLeft)), ys);
+                  weight = (MathExtensions::Ceiling(pixelSourceLeft) - pixelSourceLeft);
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+
+               for (int xs = static_cast<int>(MathExtensions::Ceiling(pixelSourceLeft)); xs < psr; xs++)
+               {
+                  PixelData pd = src.GetPixel(xs, ys);
+                  red += pd.red;
+                  green += pd.green;
+                  blue += pd.blue;
+                  alpha += pd.alpha;
+               }
+
+               if (!MathExtensions::IsIntegral(pixelSourceRight))
+               {
+                  weight = (pixelSourceRight - psr);
+                  PixelData pd = src.GetPixel(psr, ys);
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+            }
+
+            if (!MathExtensions::IsIntegral(pixelSourceBottom))
+            {
+               psb = static_cast<int>(MathExtensions::Floor(pixelSourceBottom));
+               psr = static_cast<int>(MathExtensions::Floor(pixelSourceRight));
+
+               if (!MathExtensions::IsIntegral(pixelSourceLeft))
+               {
+                  PixelData pd = src.GetPixel(static_cast<int>(MathExtensions::Floor(pixelSourceLeft)), psb);
+                  weight = (pixelSourceBottom - psb) * (MathExtensions::Ceiling(pixelSourceLeft) - pixelSourceLeft);
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+
+               weight = (pixelSourceBottom - psb);
+               for (int xs = static_cast<int>(MathExtensions::Ceiling(pixelSourceLeft)); xs < psr; xs++)
+               {
+                  PixelData pd = src.GetPixel(xs, psb);
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+
+               if (!MathExtensions::IsIntegral(pixelSourceRight))
+               {
+                  weight = (pixelSourceBottom - psb) * (pixelSourceRight - psr);
+                  PixelData pd = src.GetPixel(psr, psb);
+                  red += pd.red * weight;
+                  green += pd.green * weight;
+                  blue += pd.blue * weight;
+                  alpha += pd.alpha * weight;
+               }
+            }
+
+            result.SetPixel(x, y,
+               PixelData(static_cast<uint8_t>(MathExtensions::Limit(red / pixelSourceCount, 0.0f, 255.0f)),
+                  static_cast<uint8_t>(MathExtensions::Limit(green / pixelSourceCount, 0.0f, 255.0f)), static_cast<uint8_t>(MathExtensions::Limit(blue / pixelSourceCount, 0.0f, 255.0f)),
+                  static_cast<uint8_t>(MathExtensions::Limit(alpha / pixelSourceCount, 0.0f, 255.0f))));
+         }
+      }
+      break;
+   }
+
+   case FastBitmapDataExtractModeEnum::SinglePixelTopLeft:
+   case FastBitmapDataExtractModeEnum::SinglePixelCenter:
+   default:
+   {
+      float xSource = 0.0f;
+      float xSourceBase = 0.0f;
+      float ySource = 0.0f;
+      float xStep = static_cast<float>(sourceWidth) / resultWidth;
+      float yStep = static_cast<float>(sourceHeight) / resultHeight;
+
+      if (dataExtractMode == FastBitmapDataExtractModeEnum::SinglePixelCenter)
+      {
+         xSourceBase = xStep / 2;
+         ySource = yStep / 2;
+      }
+
+      for (int y = 0; y < resultHeight; y++)
+      {
+         xSource = xSourceBase;
+         for (int x = 0; x < resultWidth; x++)
+         {
+            result.SetPixel(x, y, src.GetPixel(MathExtensions::RoundToInt(xSource), MathExtensions::RoundToInt(ySource)));
+            xSource += xStep;
+         }
+         ySource += yStep;
+      }
+      break;
+   }
+   }
+
+   return result;
+}
+
+static const char* GetClipPath()
+{
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   return "SSE2";
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+   return "NEON";
+#else
+   return "scalar";
+#endif
+}
+
+static std::string GetModeName(FastBitmapDataExtractModeEnum mode)
+{
+   switch (mode)
+   {
+   case FastBitmapDataExtractModeEnum::BlendPixels: return "BlendPixels";
+   case FastBitmapDataExtractModeEnum::SinglePixelTopLeft: return "SinglePixelTopLeft";
+   case FastBitmapDataExtractModeEnum::SinglePixelCenter: return "SinglePixelCenter";
+   default: return "Unknown";
+   }
+}
+
+int main(int argc, char* argv[])
+{
+   int iterations = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 3000;
+
+   std::cout << "FastBitmap GetClip Test Program" << std::endl;
+   std::cout << "===============================" << std::endl;
+   std::cout << "Compares GetClip with the reference implementation on random bitmaps and clip rectangles" << std::endl;
+   std::cout << "Clip path: " << GetClipPath() << ", iterations: " << iterations << std::endl;
+
+   const FastBitmapDataExtractModeEnum modes[] = { FastBitmapDataExtractModeEnum::BlendPixels, FastBitmapDataExtractModeEnum::SinglePixelTopLeft,
+      FastBitmapDataExtractModeEnum::SinglePixelCenter };
+
+   std::mt19937 rng(42);
+   long long pixelCount = 0;
+   long long mismatchCount = 0;
+
+   for (int i = 0; i < iterations; i++)
+   {
+      int width = 1 + rng() % 97;
+      int height = 1 + rng() % 61;
+      std::vector<unsigned char> data(width * height * 4);
+      for (unsigned char& c : data)
+         c = (i % 5 == 0) ? 255 : rng() % 256;
+      FastBitmap source(width, height, data.data());
+
+      int resultWidth = 1 + rng() % 40;
+      int resultHeight = 1 + rng() % 40;
+      int sourceLeft = static_cast<int>(rng() % (width + 3)) - 1;
+      int sourceTop = static_cast<int>(rng() % (height + 3)) - 1;
+      int sourceWidth = (rng() % 4 == 0) ? -1 : std::max(1, static_cast<int>(rng() % (width + 10)));
+      int sourceHeight = (rng() % 4 == 0) ? -1 : std::max(1, static_cast<int>(rng() % (height + 10)));
+
+      for (FastBitmapDataExtractModeEnum mode : modes)
+      {
+         FastBitmap clip = source.GetClip(resultWidth, resultHeight, sourceLeft, sourceTop, sourceWidth, sourceHeight, mode);
+         FastBitmap reference = GetClipReference(source, resultWidth, resultHeight, sourceLeft, sourceTop, sourceWidth, sourceHeight, mode);
+
+         for (int y = 0; y < resultHeight; y++)
+         {
+            for (int x = 0; x < resultWidth; x++)
+            {
+               pixelCount++;
+               if (clip.GetPixel(x, y) != reference.GetPixel(x, y))
+               {
+                  if (mismatchCount < 10)
+                  {
+                     std::cout << "MISMATCH: iteration " << i << ", mode " << GetModeName(mode) << ", pixel " << x << "," << y << " (source " << width << "x" << height
+                               << ", clip " << sourceLeft << "," << sourceTop << " " << sourceWidth << "x" << sourceHeight << " -> " << resultWidth << "x" << resultHeight << ")"
+                               << std::endl;
+                  }
+                  mismatchCount++;
+               }
+            }
+         }
+      }
+   }
+
+   std::cout << "Compared " << pixelCount << " pixels, " << mismatchCount << " mismatches" << std::endl;
+
+   std::vector<unsigned char> data(256 * 128 * 4);
+   for (unsigned char& c : data)
+      c = rng() % 256;
+   FastBitmap frame(256, 128, data.data());
+
+   for (int pass = 0; pass < 2; pass++)
+   {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < 200; i++)
+      {
+         if (pass == 0)
+            frame.GetClip(32, 128, 0, 0, -1, -1, FastBitmapDataExtractModeEnum::BlendPixels);
+         else
+            GetClipReference(frame, 32, 128, 0, 0, -1, -1, FastBitmapDataExtractModeEnum::BlendPixels);
+      }
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+      std::cout << (pass == 0 ? "GetClip" : "Reference") << ": 200 blended 256x128 -> 32x128 clips in " << elapsed << " ms" << std::endl;
+   }
+
+   return (mismatchCount == 0) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "pinballsupport/InputQueue.h"
+#include "table/TableElementData.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace DOF;
+
+// InputQueue as it was before the lock-free ring, used as reference.
+class InputQueueReference : public std::queue<TableElementData>
+{
+public:
+   bool Enqueue(char tableElementTypeChar, int number, int value)
+   {
+      TableElementData tableElementData(tableElementTypeChar, number, value);
+      std::lock_guard<std::mutex> lock(m_queueLocker);
+      this->push(tableElementData);
+      return true;
+   }
+
+   int DequeueBatch(std::vector<TableElementData>& tableElementDataList, int maxCount)
+   {
+      tableElementDataList.clear();
+      while (static_cast<int>(tableElementDataList.size()) < maxCount)
+      {
+         std::lock_guard<std::mutex> lock(m_queueLocker);
+         if (this->empty())
+            break;
+         tableElementDataList.push_back(this->front());
+         this->pop();
+      }
+      return static_cast<int>(tableElementDataList.size());
+   }
+
+   uint64_t GetDroppedCount() const { return 0; }
+
+private:
+   std::mutex m_queueLocker;
+};
+
+struct BenchResult
+{
+   std::vector<long long> latenciesNs;
+   int receivedCount = 0;
+   int orderErrors = 0;
+   uint64_t fullCount = 0;
+   double elapsedMs = 0;
+};
+
+// Runs the producers against a single consumer draining in batches of 32 like the main thread does.
+// Every producer sends its events on its own solenoid number with increasing values, so the consumer can check the per-producer order.
+// The producers send as fast as they can, so they retry while the ring is full instead of losing events. The latency is the one of the successful call.
+template <typename Queue> static BenchResult RunBenchmark(int producerCount, int eventCount)
+{
+   Queue queue;
+   BenchResult result;
+   std::vector<std::vector<long long>> latencies(producerCount, std::vector<long long>(eventCount));
+   std::atomic<int> finishedProducers(0);
+   std::atomic<bool> start(false);
+
+   std::thread consumer(
+      [&]()
+      {
+         std::vector<int> lastValue(producerCount, -1);
+         std::vector<TableElementData> batch;
+         batch.reserve(32);
+         while (true)
+         {
+            bool producersDone = finishedProducers.load(std::memory_order_acquire) == producerCount;
+            if (queue.DequeueBatch(batch, 32) == 0)
+            {
+               if (producersDone)
+                  break;
+               std::this_thread::yield();
+               continue;
+            }
+            for (const TableElementData& tableElementData : batch)
+            {
+               int producer = tableElementData.m_number;
+               if (producer < 0 || producer >= producerCount || tableElementData.m_value <= lastValue[producer])
+                  result.orderErrors++;
+               else
+                  lastValue[producer] = tableElementData.m_value;
+               result.receivedCount++;
+            }
+         }
+      });
+
+   std::vector<std::thread> producers;
+   for (int p = 0; p < producerCount; p++)
+   {
+      producers.emplace_back(
+         [&, p]()
+         {
+            while (!start.load(std::memory_order_acquire))
+               std::this_thread::yield();
+            std::vector<long long>& producerLatencies = latencies[p];
+            for (int i = 0; i < eventCount; i++)
+            {
+               while (true)
+               {
+                  auto before = std::chrono::steady_clock::now();
+                  bool enqueued = queue.Enqueue('S', p, i);
+                  producerLatencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - before).count();
+                  if (enqueued)
+                     break;
+                  std::this_thread::yield();
+               }
+            }
+            finishedProducers.fetch_add(1, std::memory_order_release);
+         });
+   }
+
+   auto startTime = std::chrono::steady_clock::now();
+   start.store(true, std::memory_order_release);
+   for (std::thread& producer : producers)
+      producer.join();
+   consumer.join();
+   result.elapsedMs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count() / 1000.0;
+   result.fullCount = queue.GetDroppedCount();
+
+   for (const std::vector<long long>& producerLatencies : latencies)
+      result.latenciesNs.insert(result.latenciesNs.end(), producerLatencies.begin(), producerLatencies.end());
+   std::sort(result.latenciesNs.begin(), result.latenciesNs.end());
+   return result;
+}
+
+static void PrintResult(const char* name, const BenchResult& result)
+{
+   const std::vector<long long>& l = result.latenciesNs;
+   long long sum = 0;
+   for (long long ns : l)
+      sum += ns;
+   auto percentile = [&l](double p) { return l[std::min(l.size() - 1, static_cast<size_t>(p * l.size()))]; };
+
+   std::cout << name << ": " << result.receivedCount << " events received, " << result.fullCount << " retries on a full queue, " << result.orderErrors << " out of order, "
+             << result.elapsedMs << " ms" << std::endl;
+   std::cout << "   enqueue latency avg " << (sum / static_cast<long long>(l.size())) << " ns, p50 " << percentile(0.5) << " ns, p99 " << percentile(0.99) << " ns, p99.9 "
+             << percentile(0.999) << " ns, max " << l.back() << " ns" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+   int producerCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 3;
+   int eventCount = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 200000;
+
+   std::cout << "InputQueue Benchmark Program" << std::endl;
+   std::cout << "============================" << std::endl;
+   std::cout << producerCount << " producers enqueue " << eventCount << " events each while one consumer drains the queue" << std::endl;
+
+   BenchResult result = RunBenchmark<InputQueue>(producerCount, eventCount);
+   BenchResult reference = RunBenchmark<InputQueueReference>(producerCount, eventCount);
+   PrintResult("InputQueue", result);
+   PrintResult("Reference", reference);
+
+   int expectedCount = producerCount * eventCount;
+   bool ok = result.receivedCount == expectedCount && result.orderErrors == 0;
+   std::cout << (ok ? "OK" : "FAILED") << ": " << result.receivedCount << " of " << expectedCount << " events received in producer order" << std::endl;
+   return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "ledcontrol/loader/LedControlVariableResolver.h"
+#include "ledcontrol/loader/TableVariablesDictionary.h"
+#include "ledcontrol/loader/VariablesDictionary.h"
+#include "general/StringExtensions.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace DOF;
+
+struct IniSections
+{
+   std::vector<std::string> outData;
+   std::vector<std::string> variableData;
+   std::vector<std::string> tableVariableData;
+};
+
+// Splits the file into the sections used for variable resolution, trimming and skipping lines the same way LedControlConfig does.
+static bool ReadIniSections(const std::string& filename, IniSections& sections)
+{
+   std::ifstream file(filename, std::ios::binary);
+   if (!file)
+      return false;
+
+   std::vector<std::string>* target = nullptr;
+   bool outSeen = false;
+   bool variablesSeen = false;
+   bool tableVariablesSeen = false;
+
+   std::string line;
+   while (std::getline(file, line))
+   {
+      line = StringExtensions::Trim(line);
+      if (line.empty() || line[0] == '#')
+         continue;
+
+      if (line[0] == '[' && line.back() == ']' && line.length() > 2)
+      {
+         target = nullptr;
+         if ((line == "[Config DOF]" || line == "[Config outs]") && !outSeen)
+         {
+            target = &sections.outData;
+            outSeen = true;
+         }
+         else if (line == "[Variables DOF]" && !variablesSeen)
+         {
+            target = &sections.variableData;
+            variablesSeen = true;
+         }
+         else if (line == "[TableVariables]" && !tableVariablesSeen)
+         {
+            target = &sections.tableVariableData;
+            tableVariablesSeen = true;
+         }
+      }
+      else if (target)
+      {
+         target->push_back(line);
+      }
+   }
+   return true;
+}
+
+static std::string GetVariableToken(const std::string& name)
+{
+   std::string n = name;
+   if (!StringExtensions::StartsWith(n, "@"))
+      n = "@" + n;
+   if (!StringExtensions::EndsWith(n, "@"))
+      n += "@";
+   return n;
+}
+
+// ResolveTableVariables as it was before the single pass substitution, used as reference.
+static void ResolveTableVariablesReference(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData)
+{
+   TableVariablesDictionary vd(variableData);
+
+   for (size_t i = 0; i < dataToResolve.size(); i++)
+   {
+      std::string d = StringExtensions::Trim(dataToResolve[i]);
+      bool updated = false;
+      if (!StringExtensions::IsNullOrWhiteSpace(d))
+      {
+         size_t tp = d.find(",");
+         if (tp != std::string::npos && tp > 0)
+         {
+            std::string tableName = StringExtensions::Trim(d.substr(0, tp));
+            if (vd.find(tableName) != vd.end())
+            {
+               for (const auto& kv : vd[tableName])
+               {
+                  d = StringExtensions::Replace(d, GetVariableToken(kv.first), kv.second);
+                  updated = true;
+               }
+            }
+         }
+      }
+      if (updated)
+         dataToResolve[i] = d;
+   }
+}
+
+// ResolveVariables as it was before the single pass substitution. The old code replaced the variables one after another in hash map order,
+// so variables used inside other variables only resolved for some orders. Repeating the passes gives the nested result the new resolver guarantees.
+static void ResolveVariablesReference(std::vector<std::string>& dataToResolve, const std::vector<std::string>& variableData)
+{
+   VariablesDictionary vd(variableData);
+
+   for (int pass = 0; pass < 8; pass++)
+   {
+      bool changed = false;
+      for (const auto& kv : vd)
+      {
+         std::string n = GetVariableToken(kv.first);
+         for (size_t i = 0; i < dataToResolve.size(); i++)
+         {
+            std::string d = StringExtensions::Replace(dataToResolve[i], n, kv.second);
+            if (d != dataToResolve[i])
+            {
+               dataToResolve[i] = d;
+               changed = true;
+            }
+         }
+      }
+      if (!changed)
+         break;
+   }
+}
+
+static int CompareFile(const std::string& filename)
+{
+   IniSections sections;
+   if (!ReadIniSections(filename, sections))
+   {
+      std::cout << "ERROR: Could not read " << filename << std::endl;
+      return -1;
+   }
+
+   std::vector<std::string> reference = sections.outData;
+   auto start = std::chrono::steady_clock::now();
+   ResolveTableVariablesReference(reference, sections.tableVariableData);
+   ResolveVariablesReference(reference, sections.variableData);
+   auto referenceElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+   std::vector<std::string> resolved = sections.outData;
+   start = std::chrono::steady_clock::now();
+   LedControlVariableResolver::ResolveTableVariables(resolved, sections.tableVariableData);
+   LedControlVariableResolver::ResolveVariables(resolved, sections.variableData);
+   auto resolvedElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+   int mismatchCount = 0;
+   for (size_t i = 0; i < resolved.size(); i++)
+   {
+      if (resolved[i] != reference[i])
+      {
+         if (mismatchCount < 10)
+         {
+            std::cout << "MISMATCH: " << filename << " row " << i << std::endl;
+            std::cout << "   source:    " << sections.outData[i] << std::endl;
+            std::cout << "   reference: " << reference[i] << std::endl;
+            std::cout << "   resolved:  " << resolved[i] << std::endl;
+         }
+         mismatchCount++;
+      }
+   }
+
+   std::cout << filename << ": " << resolved.size() << " rows, " << sections.variableData.size() << " variables, " << sections.tableVariableData.size() << " table variable rows, "
+             << mismatchCount << " mismatches (reference " << referenceElapsed << " us, resolver " << resolvedElapsed << " us)" << std::endl;
+   return mismatchCount;
+}
+
+int main(int argc, char* argv[])
+{
+   std::cout << "LedControl Variable Resolution Test Program" << std::endl;
+   std::cout << "===========================================" << std::endl;
+
+   if (argc < 2)
+   {
+      std::cout << "Usage: " << argv[0] << " <directoutputconfig.ini> [<directoutputconfig.ini> ...]" << std::endl;
+      std::cout << "Compares the resolved [Config DOF] rows of each file with the reference implementation" << std::endl;
+      return 1;
+   }
+
+   int failedFiles = 0;
+   for (int i = 1; i < argc; i++)
+   {
+      if (CompareFile(argv[i]) != 0)
+         failedFiles++;
+   }
+
+   std::cout << (argc - 1) << " files compared, " << failedFiles << " failed" << std::endl;
+   return (failedFiles == 0) ? 0 : 1;
+}
\ No newline at end of file
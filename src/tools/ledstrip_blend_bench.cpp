@@ -0,0 +1,277 @@
+#include "cab/toys/layer/AlphaMappingTable.h"
+#include "cab/toys/layer/RGBALayerBlender.h"
+#include "general/analog/AnalogAlpha.h"
+#include "general/color/RGBAColor.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BENCH_BLEND_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define BENCH_BLEND_NEON
+#endif
+
+using namespace DOF;
+
+static uint8_t s_fadingTable[256];
+
+// Layer blending of LedStrip::SetOutputData as it was before the integer compositor, used as reference.
+// Uses RGB order, LeftRightTopDown arrangement and a linear fading curve at full brightness.
+static void SetOutputDataReference(const std::vector<std::vector<RGBAColor>>& layers, int width, int height, std::vector<uint8_t>& outputData)
+{
+   std::array<float, 3> defaultValue = { { 0.0f, 0.0f, 0.0f } };
+   std::vector<std::vector<std::array<float, 3>>> value(width, std::vector<std::array<float, 3>>(height, defaultValue));
+
+   for (const std::vector<RGBAColor>& layer : layers)
+   {
+      const RGBAColor* d = layer.data();
+
+      int nr = 0;
+      for (int y = 0; y < height; y++)
+      {
+         for (int x = 0; x < width; x++)
+         {
+            int alpha = std::clamp(d[nr].GetAlpha(), 0, 255);
+            if (alpha != 0)
+            {
+               value[x][y][0] = AlphaMappingTable::AlphaMapping[255 - alpha][static_cast<int>(value[x][y][0])] + AlphaMappingTable::AlphaMapping[alpha][std::clamp(d[nr].GetRed(), 0, 255)];
+               value[x][y][1]
+                  = AlphaMappingTable::AlphaMapping[255 - alpha][static_cast<int>(value[x][y][1])] + AlphaMappingTable::AlphaMapping[alpha][std::clamp(d[nr].GetGreen(), 0, 255)];
+               value[x][y][2] = AlphaMappingTable::AlphaMapping[255 - alpha][static_cast<int>(value[x][y][2])] + AlphaMappingTable::AlphaMapping[alpha][std::clamp(d[nr].GetBlue(), 0, 255)];
+            }
+            nr++;
+         }
+      }
+   }
+
+   for (int y = 0; y < height; y++)
+   {
+      for (int x = 0; x < width; x++)
+      {
+         int outputNumber = (y * width + x) * 3;
+         outputData[outputNumber] = s_fadingTable[static_cast<int>(value[x][y][0])];
+         outputData[outputNumber + 1] = s_fadingTable[static_cast<int>(value[x][y][1])];
+         outputData[outputNumber + 2] = s_fadingTable[static_cast<int>(value[x][y][2])];
+      }
+   }
+}
+
+// Full frame update of LedStrip::SetOutputData with the same settings as the reference.
+static void SetOutputData(const std::vector<std::vector<RGBAColor>>& layers, int ledCount, std::vector<uint16_t>& compositeData, std::vector<uint8_t>& outputData)
+{
+   std::fill(compositeData.begin(), compositeData.end(), 0);
+   for (const std::vector<RGBAColor>& layer : layers)
+      RGBALayerBlender::BlendLayer(compositeData.data(), layer.data(), ledCount);
+
+   for (int x = 0; x < ledCount * 3; x++)
+      outputData[x] = s_fadingTable[compositeData[x + x / 3]];
+}
+
+// Channel layout of RGBAColor and AnalogAlpha before the channels were stored as bytes, used as reference.
+struct RGBAColorReference
+{
+   int red;
+   int green;
+   int blue;
+   int alpha;
+};
+
+struct AnalogAlphaReference
+{
+   int value;
+   int alpha;
+};
+
+// BlendLayer as it was for int channels, used as reference.
+static void BlendLayerReference(uint16_t* compositeData, const RGBAColorReference* layer, int count)
+{
+   const int* src = reinterpret_cast<const int*>(layer);
+   int nr = 0;
+
+#if defined(BENCH_BLEND_SSE2)
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i max = _mm_set1_epi16(255);
+   const __m128i one = _mm_set1_epi16(1);
+   for (; nr + 2 <= count; nr += 2)
+   {
+      __m128i color = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nr * 4)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nr * 4 + 4)));
+      color = _mm_min_epi16(_mm_max_epi16(color, zero), max);
+      __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+      __m128i composite = _mm_loadu_si128(reinterpret_cast<const __m128i*>(compositeData + nr * 4));
+      __m128i v = _mm_add_epi16(_mm_mullo_epi16(composite, _mm_sub_epi16(max, alpha)), _mm_mullo_epi16(color, alpha));
+      v = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(v, one), _mm_srli_epi16(v, 8)), 8);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(compositeData + nr * 4), v);
+   }
+#elif defined(BENCH_BLEND_NEON)
+   const uint16x8_t max = vdupq_n_u16(255);
+   for (; nr + 2 <= count; nr += 2)
+   {
+      uint16x8_t color = vcombine_u16(vqmovun_s32(vld1q_s32(src + nr * 4)), vqmovun_s32(vld1q_s32(src + nr * 4 + 4)));
+      color = vminq_u16(color, max);
+      uint16x8_t alpha = vcombine_u16(vdup_n_u16(vgetq_lane_u16(color, 3)), vdup_n_u16(vgetq_lane_u16(color, 7)));
+      uint16x8_t composite = vld1q_u16(compositeData + nr * 4);
+      uint16x8_t v = vmlaq_u16(vmulq_u16(composite, vsubq_u16(max, alpha)), color, alpha);
+      v = vshrq_n_u16(vaddq_u16(vaddq_u16(v, vdupq_n_u16(1)), vshrq_n_u16(v, 8)), 8);
+      vst1q_u16(compositeData + nr * 4, v);
+   }
+#endif
+
+   for (; nr < count; nr++)
+   {
+      int alpha = std::clamp(src[nr * 4 + 3], 0, 255);
+      if (alpha == 0)
+         continue;
+
+      uint16_t* composite = compositeData + nr * 4;
+      for (int i = 0; i < 3; i++)
+      {
+         int v = composite[i] * (255 - alpha) + std::clamp(src[nr * 4 + i], 0, 255) * alpha;
+         composite[i] = static_cast<uint16_t>((v + 1 + (v >> 8)) >> 8);
+      }
+   }
+}
+
+static std::vector<std::vector<RGBAColor>> CreateLayers(std::mt19937& rng, int layerCount, int ledCount)
+{
+   std::vector<std::vector<RGBAColor>> layers(layerCount, std::vector<RGBAColor>(ledCount));
+   for (std::vector<RGBAColor>& layer : layers)
+   {
+      for (RGBAColor& color : layer)
+      {
+         int alphaType = static_cast<int>(rng() % 4);
+         int alpha = (alphaType == 0) ? 0 : (alphaType == 1) ? 255 : static_cast<int>(rng() % 256);
+         color.SetRGBA(static_cast<int>(rng() % 256), static_cast<int>(rng() % 256), static_cast<int>(rng() % 256), alpha);
+      }
+   }
+   return layers;
+}
+
+static int CompareOutputs(std::mt19937& rng, int layerCount, int ledCount, int frameCount)
+{
+   std::vector<uint16_t> compositeData(ledCount * 4);
+   std::vector<uint8_t> outputData(ledCount * 3);
+   std::vector<uint8_t> referenceData(ledCount * 3);
+
+   int mismatchCount = 0;
+   for (int frame = 0; frame < frameCount; frame++)
+   {
+      std::vector<std::vector<RGBAColor>> layers = CreateLayers(rng, layerCount, ledCount);
+      SetOutputDataReference(layers, ledCount, 1, referenceData);
+      SetOutputData(layers, ledCount, compositeData, outputData);
+      for (int i = 0; i < ledCount * 3; i++)
+      {
+         if (outputData[i] != referenceData[i])
+         {
+            if (mismatchCount < 10)
+               std::cout << "MISMATCH: frame " << frame << " output " << i << " reference " << static_cast<int>(referenceData[i]) << " compositor " << static_cast<int>(outputData[i])
+                         << std::endl;
+            mismatchCount++;
+         }
+      }
+   }
+   return mismatchCount;
+}
+
+// Blends a large layer set with the byte channel layout and with the previous int channel layout. The int layers exceed the L2 cache of most machines.
+static bool CompareChannelLayout(std::mt19937& rng, int ledCount, int layerCount, int frameCount)
+{
+   std::vector<std::vector<RGBAColor>> layers = CreateLayers(rng, layerCount, ledCount);
+   std::vector<std::vector<RGBAColorReference>> referenceLayers(layerCount, std::vector<RGBAColorReference>(ledCount));
+   for (int l = 0; l < layerCount; l++)
+   {
+      for (int i = 0; i < ledCount; i++)
+         referenceLayers[l][i] = { layers[l][i].GetRed(), layers[l][i].GetGreen(), layers[l][i].GetBlue(), layers[l][i].GetAlpha() };
+   }
+
+   std::vector<uint16_t> compositeData(ledCount * 4);
+   std::vector<uint16_t> referenceCompositeData(ledCount * 4);
+
+   auto start = std::chrono::steady_clock::now();
+   for (int frame = 0; frame < frameCount; frame++)
+   {
+      std::fill(referenceCompositeData.begin(), referenceCompositeData.end(), 0);
+      for (const std::vector<RGBAColorReference>& layer : referenceLayers)
+         BlendLayerReference(referenceCompositeData.data(), layer.data(), ledCount);
+   }
+   auto referenceUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0 / frameCount;
+
+   start = std::chrono::steady_clock::now();
+   for (int frame = 0; frame < frameCount; frame++)
+   {
+      std::fill(compositeData.begin(), compositeData.end(), 0);
+      for (const std::vector<RGBAColor>& layer : layers)
+         RGBALayerBlender::BlendLayer(compositeData.data(), layer.data(), ledCount);
+   }
+   auto blendUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0 / frameCount;
+
+   size_t layerBytes = static_cast<size_t>(ledCount) * layerCount * sizeof(RGBAColor);
+   size_t referenceLayerBytes = static_cast<size_t>(ledCount) * layerCount * sizeof(RGBAColorReference);
+   bool identical = compositeData == referenceCompositeData;
+
+   std::cout << ledCount << " leds, " << layerCount << " layers, " << frameCount << " frames, " << (identical ? "identical" : "MISMATCHING") << " composite" << std::endl;
+   double ledLayers = static_cast<double>(ledCount) * layerCount;
+   std::cout << "   int channels:  " << referenceLayerBytes / 1024 << " KiB of layers, " << referenceUs << " us per frame, " << (ledLayers / referenceUs) << " million leds per second"
+             << std::endl;
+   std::cout << "   byte channels: " << layerBytes / 1024 << " KiB of layers, " << blendUs << " us per frame, " << (ledLayers / blendUs) << " million leds per second" << std::endl;
+   return identical;
+}
+
+int main(int argc, char* argv[])
+{
+   int ledCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 1000;
+   int layerCount = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 4;
+   const int frameCount = 2000;
+
+   std::cout << "LedStrip Blend Benchmark Program" << std::endl;
+   std::cout << "================================" << std::endl;
+
+   for (int i = 0; i < 256; i++)
+      s_fadingTable[i] = static_cast<uint8_t>(i);
+
+   std::mt19937 rng(42);
+
+   int compareLedCount = 1001;
+   int compareFrames = 200;
+   int mismatchCount = CompareOutputs(rng, 4, compareLedCount, compareFrames);
+   std::cout << "Compared " << compareFrames << " random 4-layer frames of " << compareLedCount << " leds with the reference: " << mismatchCount << " mismatching outputs" << std::endl;
+
+   std::vector<std::vector<RGBAColor>> layers = CreateLayers(rng, layerCount, ledCount);
+   std::vector<uint16_t> compositeData(ledCount * 4);
+   std::vector<uint8_t> outputData(ledCount * 3);
+   unsigned int checksum = 0;
+
+   auto start = std::chrono::steady_clock::now();
+   for (int frame = 0; frame < frameCount; frame++)
+   {
+      SetOutputDataReference(layers, ledCount, 1, outputData);
+      checksum += outputData[frame % outputData.size()];
+   }
+   auto referenceUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0 / frameCount;
+
+   start = std::chrono::steady_clock::now();
+   for (int frame = 0; frame < frameCount; frame++)
+   {
+      SetOutputData(layers, ledCount, compositeData, outputData);
+      checksum += outputData[frame % outputData.size()];
+   }
+   auto compositorUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / 1000.0 / frameCount;
+
+   std::cout << ledCount << " leds, " << layerCount << " layers, " << frameCount << " frames (checksum " << checksum << ")" << std::endl;
+   std::cout << "   reference:  " << referenceUs << " us per frame" << std::endl;
+   std::cout << "   compositor: " << compositorUs << " us per frame" << std::endl;
+
+   std::cout << std::endl;
+   std::cout << "sizeof(RGBAColor) " << sizeof(RGBAColor) << " bytes (int channels " << sizeof(RGBAColorReference) << "), sizeof(AnalogAlpha) " << sizeof(AnalogAlpha)
+             << " bytes (int channels " << sizeof(AnalogAlphaReference) << ")" << std::endl;
+   bool layoutIdentical = CompareChannelLayout(rng, 5000, 12, 500);
+
+   return (mismatchCount == 0 && layoutIdentical) ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include "cab/out/adressableledstrip/TeensyStripController.h"
+#include <libserialport.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace DOF;
+
+// Simulates a Teensy running the DOF firmware behind a serial port. Written bytes reach the device at the transfer rate and every command
+// is answered a round trip time after it arrived. The device handles the commands in the order they were written.
+class FakeTeensy
+{
+public:
+   void Write(const uint8_t* data, size_t count)
+   {
+      m_transferEndTime = std::max(std::chrono::steady_clock::now(), m_transferEndTime) + std::chrono::microseconds(static_cast<long long>(count) * 1000000 / m_bytesPerSecond);
+      m_received.insert(m_received.end(), data, data + count);
+      while (HandleCommand())
+      {
+      }
+   }
+
+   int Read(uint8_t* buffer, size_t count, unsigned int timeoutMs)
+   {
+      auto timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+      size_t bytesRead = 0;
+      while (bytesRead < count && !m_responses.empty() && m_responses.front().readyTime <= timeout)
+      {
+         std::this_thread::sleep_until(m_responses.front().readyTime);
+         buffer[bytesRead++] = m_responses.front().value;
+         m_responses.pop_front();
+      }
+      return static_cast<int>(bytesRead);
+   }
+
+   int GetInputWaiting() const
+   {
+      auto now = std::chrono::steady_clock::now();
+      int count = 0;
+      for (const Response& response : m_responses)
+      {
+         if (response.readyTime <= now)
+            count++;
+      }
+      return count;
+   }
+
+   void Flush()
+   {
+      m_received.clear();
+      m_responses.clear();
+   }
+
+   void ResetCounters()
+   {
+      m_ledDataCommandCount = 0;
+      m_outputCommandCount = 0;
+   }
+
+   int GetLedDataCommandCount() const { return m_ledDataCommandCount; }
+   int GetOutputCommandCount() const { return m_outputCommandCount; }
+   void SetRoundTripUs(int value) { m_roundTripUs = value; }
+   void SetBytesPerSecond(int value) { m_bytesPerSecond = value; }
+   void SetNakChannel(int value) { m_nakChannel = value; }
+   void SetNakOutput(bool value) { m_nakOutput = value; }
+
+   static const int MaxLedsPerChannel = 1100;
+
+private:
+   struct Response
+   {
+      uint8_t value;
+      std::chrono::steady_clock::time_point readyTime;
+   };
+
+   bool HandleCommand()
+   {
+      if (m_received.empty())
+         return false;
+
+      switch (m_received[0])
+      {
+      case 0:
+      case 'C': Respond(1, { 'A' }); return true;
+      case 'M': Respond(1, { static_cast<uint8_t>(MaxLedsPerChannel >> 8), static_cast<uint8_t>(MaxLedsPerChannel & 255), 'A' }); return true;
+      case 'L':
+         if (m_received.size() < 3)
+            return false;
+         m_ledsPerChannel = m_received[1] * 256 + m_received[2];
+         Respond(3, { 'A' });
+         return true;
+      case 'O':
+         m_outputCommandCount++;
+         Respond(1, { static_cast<uint8_t>(m_nakOutput ? 'N' : 'A') });
+         return true;
+      case 'R':
+      {
+         if (m_received.size() < 5)
+            return false;
+         int targetPosition = m_received[1] * 256 + m_received[2];
+         size_t length = 5 + (m_received[3] * 256 + m_received[4]) * 3;
+         if (m_received.size() < length)
+            return false;
+         int channel = (m_ledsPerChannel > 0) ? targetPosition / m_ledsPerChannel : -1;
+         m_ledDataCommandCount++;
+         Respond(length, { static_cast<uint8_t>(channel == m_nakChannel ? 'N' : 'A') });
+         return true;
+      }
+      default: m_received.pop_front(); return true;
+      }
+   }
+
+   void Respond(size_t commandLength, std::initializer_list<uint8_t> answer)
+   {
+      m_received.erase(m_received.begin(), m_received.begin() + commandLength);
+      auto readyTime = m_transferEndTime + std::chrono::microseconds(m_roundTripUs);
+      for (uint8_t value : answer)
+         m_responses.push_back({ value, readyTime });
+   }
+
+   std::deque<uint8_t> m_received;
+   std::deque<Response> m_responses;
+   int m_ledsPerChannel = 0;
+   int m_ledDataCommandCount = 0;
+   int m_outputCommandCount = 0;
+   std::chrono::steady_clock::time_point m_transferEndTime;
+   int m_roundTripUs = 1000;
+   int m_bytesPerSecond = 1000000;
+   int m_nakChannel = -1;
+   bool m_nakOutput = false;
+};
+
+static FakeTeensy s_teensy;
+static const char* s_portName = "FAKE0";
+
+struct sp_port
+{
+   std::string name;
+};
+
+// libserialport functions used by TeensyStripController, backed by the fake device.
+enum sp_return sp_list_ports(struct sp_port*** list_ptr)
+{
+   *list_ptr = new sp_port*[2] { new sp_port { s_portName }, nullptr };
+   return SP_OK;
+}
+
+void sp_free_port_list(struct sp_port** ports)
+{
+   for (int i = 0; ports[i]; i++)
+      delete ports[i];
+   delete[] ports;
+}
+
+enum sp_return sp_get_port_by_name(const char* portname, struct sp_port** port_ptr)
+{
+   if (std::strcmp(portname, s_portName) != 0)
+      return SP_ERR_ARG;
+   *port_ptr = new sp_port { portname };
+   return SP_OK;
+}
+
+void sp_free_port(struct sp_port* port) { delete port; }
+char* sp_get_port_name(const struct sp_port* port) { return const_cast<char*>(port->name.c_str()); }
+char* sp_last_error_message(void) { return const_cast<char*>("fake port error"); }
+enum sp_return sp_open(struct sp_port*, enum sp_mode) { return SP_OK; }
+enum sp_return sp_close(struct sp_port*) { return SP_OK; }
+enum sp_return sp_set_baudrate(struct sp_port*, int) { return SP_OK; }
+enum sp_return sp_set_bits(struct sp_port*, int) { return SP_OK; }
+enum sp_return sp_set_parity(struct sp_port*, enum sp_parity) { return SP_OK; }
+enum sp_return sp_set_stopbits(struct sp_port*, int) { return SP_OK; }
+enum sp_return sp_set_dtr(struct sp_port*, enum sp_dtr) { return SP_OK; }
+
+enum sp_return sp_flush(struct sp_port*, enum sp_buffer)
+{
+   s_teensy.Flush();
+   return SP_OK;
+}
+
+enum sp_return sp_input_waiting(struct sp_port*) { return static_cast<enum sp_return>(s_teensy.GetInputWaiting()); }
+
+enum sp_return sp_blocking_write(struct sp_port*, const void* buf, size_t count, unsigned int)
+{
+   s_teensy.Write(static_cast<const uint8_t*>(buf), count);
+   return static_cast<enum sp_return>(count);
+}
+
+enum sp_return sp_blocking_read(struct sp_port*, void* buf, size_t count, unsigned int timeout_ms)
+{
+   return static_cast<enum sp_return>(s_teensy.Read(static_cast<uint8_t*>(buf), count, timeout_ms));
+}
+
+// Gives the test access to the connection and the update methods the updater thread normally calls.
+class TeensyTestController : public TeensyStripController
+{
+public:
+   using TeensyStripController::ConnectToController;
+   using TeensyStripController::DisconnectFromController;
+   using TeensyStripController::GetComPort;
+   using TeensyStripController::UpdateOutputs;
+};
+
+static bool ExpectAckError(TeensyTestController& controller, const std::vector<uint8_t>& outputValues, const std::vector<OutputControllerCompleteBase::OutputValueRange>& changedRanges,
+   const std::string& expectedText)
+{
+   bool ok = false;
+   std::string message = "no exception";
+   try
+   {
+      controller.UpdateOutputs(outputValues, changedRanges);
+   }
+   catch (const std::exception& e)
+   {
+      message = e.what();
+      ok = message.find(expectedText) != std::string::npos;
+   }
+   s_teensy.Flush();
+   s_teensy.SetNakChannel(-1);
+   s_teensy.SetNakOutput(false);
+
+   std::cout << "   " << (ok ? "OK" : "FAILED") << ": expected '" << expectedText << "', got: " << message << std::endl;
+   return ok;
+}
+
+static double MeasureFrameRate(TeensyTestController& controller, std::vector<uint8_t>& outputValues, const std::vector<OutputControllerCompleteBase::OutputValueRange>& changedRanges,
+   int frameCount, const char* name)
+{
+   s_teensy.ResetCounters();
+   auto start = std::chrono::steady_clock::now();
+   for (int frame = 0; frame < frameCount; frame++)
+   {
+      outputValues[frame % outputValues.size()]++;
+      controller.UpdateOutputs(outputValues, changedRanges);
+   }
+   double seconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() / 1000000.0;
+   double frameRate = frameCount / seconds;
+
+   std::cout << "   " << name << ": " << frameRate << " frames per second, " << static_cast<double>(s_teensy.GetLedDataCommandCount()) / frameCount << " R and "
+             << static_cast<double>(s_teensy.GetOutputCommandCount()) / frameCount << " O commands per frame" << std::endl;
+   return frameRate;
+}
+
+int main(int argc, char* argv[])
+{
+   int roundTripUs = (argc > 1) ? std::max(0, std::atoi(argv[1])) : 1000;
+   int bytesPerSecond = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 1000000;
+   const int stripCount = 8;
+   const int ledsPerStrip = 256;
+   const int frameCount = 200;
+
+   std::cout << "Teensy Strip Controller Test Program" << std::endl;
+   std::cout << "====================================" << std::endl;
+   std::cout << stripCount << " strips of " << ledsPerStrip << " leds on a simulated Teensy with " << roundTripUs << " us round trip and " << bytesPerSecond << " bytes per second"
+             << std::endl;
+
+   TeensyTestController controller;
+   controller.SetComPortName(s_portName);
+   controller.SetNumberOfLedsStrip1(ledsPerStrip);
+   controller.SetNumberOfLedsStrip2(ledsPerStrip);
+   controller.SetNumberOfLedsStrip3(ledsPerStrip);
+   controller.SetNumberOfLedsStrip4(ledsPerStrip);
+   controller.SetNumberOfLedsStrip5(ledsPerStrip);
+   controller.SetNumberOfLedsStrip6(ledsPerStrip);
+   controller.SetNumberOfLedsStrip7(ledsPerStrip);
+   controller.SetNumberOfLedsStrip8(ledsPerStrip);
+
+   s_teensy.SetRoundTripUs(roundTripUs);
+   s_teensy.SetBytesPerSecond(bytesPerSecond);
+   controller.ConnectToController();
+   if (!controller.GetComPort())
+   {
+      std::cout << "FAILED: Could not connect to the simulated Teensy" << std::endl;
+      return 1;
+   }
+
+   std::vector<uint8_t> outputValues(stripCount * ledsPerStrip * 3, 0);
+   std::vector<OutputControllerCompleteBase::OutputValueRange> fullRange = { { 0, static_cast<int>(outputValues.size()) } };
+   std::vector<OutputControllerCompleteBase::OutputValueRange> strip3And7 = { { 2 * ledsPerStrip * 3 + 10, 3 }, { 6 * ledsPerStrip * 3, 6 } };
+   std::vector<OutputControllerCompleteBase::OutputValueRange> strip3 = { { 2 * ledsPerStrip * 3 + 10, 3 } };
+   bool ok = true;
+
+   std::cout << "ACK order:" << std::endl;
+   for (bool pipelined : { false, true })
+   {
+      controller.SetPipelinedAcks(pipelined);
+      std::cout << "  " << (pipelined ? "pipelined" : "sequential") << " ACKs" << std::endl;
+      s_teensy.SetNakChannel(4);
+      ok &= ExpectAckError(controller, outputValues, fullRange, "channel 5 ");
+      s_teensy.SetNakChannel(6);
+      ok &= ExpectAckError(controller, outputValues, strip3And7, "channel 7 ");
+      s_teensy.SetNakOutput(true);
+      ok &= ExpectAckError(controller, outputValues, fullRange, "output command");
+   }
+
+   s_teensy.ResetCounters();
+   controller.UpdateOutputs(outputValues, {});
+   bool nothingSent = s_teensy.GetLedDataCommandCount() == 0 && s_teensy.GetOutputCommandCount() == 0;
+   std::cout << "Unchanged frame: " << (nothingSent ? "OK, nothing sent" : "FAILED, commands were sent") << std::endl;
+   ok &= nothingSent;
+
+   std::cout << "Frame rate:" << std::endl;
+   controller.SetPipelinedAcks(false);
+   double before = MeasureFrameRate(controller, outputValues, fullRange, frameCount, "all strips, sequential ACKs (before)");
+   controller.SetPipelinedAcks(true);
+   double pipelined = MeasureFrameRate(controller, outputValues, fullRange, frameCount, "all strips, pipelined ACKs");
+   MeasureFrameRate(controller, outputValues, strip3, frameCount, "one changed strip, pipelined ACKs");
+   std::cout << "   pipelining speedup for full frames: " << pipelined / before << "x" << std::endl;
+
+   controller.DisconnectFromController();
+   std::cout << (ok ? "OK" : "FAILED") << std::endl;
+   return ok ? 0 : 1;
+}
\ No newline at end of file